@@ -0,0 +1,51 @@
+// 大树上的插入、拷贝、清空和查找后删除耗时，默认 1000 万个随机键
+// g++ -std=c++17 -O2 -I../src iterative.cpp -o iterative && ./iterative [n]
+#include "map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main(int argc, char **argv)
+{
+	int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+	std::vector<int> keys(n);
+	for (int i = 0; i < n; ++i)
+	{
+		keys[i] = i;
+	}
+	std::mt19937 rng(5);
+	std::shuffle(keys.begin(), keys.end(), rng);
+
+	sjtu::map<int, int> m;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		m.insert(sjtu::pair<const int, int>(keys[i], i));
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	printf("insert %.0f ms, ", ms(t0, t1));
+	{
+		sjtu::map<int, int> c(m);
+		std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+		printf("copy %.0f ms, ", ms(t1, t2));
+		c.clear();
+		printf("clear %.0f ms, ", ms(t2, std::chrono::steady_clock::now()));
+	}
+	std::shuffle(keys.begin(), keys.end(), rng);
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		m.erase(m.find(keys[i]));
+	}
+	std::chrono::steady_clock::time_point t4 = std::chrono::steady_clock::now();
+	printf("find+erase %.0f ms (%zu left)\n", ms(t3, t4), m.size());
+	return 0;
+}
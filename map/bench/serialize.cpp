@@ -0,0 +1,43 @@
+// 存档读写：100 万个随机键的 map 存档后读回（按升序直接建平衡树），与逐个 insert 重建对比
+// g++ -std=c++17 -O2 -I../src serialize.cpp -o serialize && ./serialize [n]
+#include "map.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main(int argc, char **argv)
+{
+	int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	sjtu::map<int, std::string> m;
+	for (int i = 0; i < n; ++i)
+	{
+		m[static_cast<int>(i * 2654435761u % n)] = std::to_string(i);
+	}
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	std::stringstream out;
+	m.save(out);
+	std::string blob = out.str();
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	sjtu::map<int, std::string> loaded;
+	{
+		std::stringstream in(blob);
+		loaded.load(in);
+	}
+	std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+	sjtu::map<int, std::string> inserted;
+	for (sjtu::map<int, std::string>::const_iterator it = m.cbegin(); it != m.cend(); ++it)
+	{
+		inserted.insert(*it);
+	}
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	printf("save %.1f ms, load %.1f ms, insert one by one %.1f ms (%zu %zu)\n", ms(t0, t1), ms(t1, t2), ms(t2, t3),
+		   loaded.size(), inserted.size());
+	return 0;
+}
@@ -0,0 +1,72 @@
+// 字符串键的比较次数与耗时：普通 less 与带 three_way 的比较器，20 万个键各查找 10 轮
+// g++ -std=c++17 -O2 -I../src three_way.cpp -o three_way && ./three_way
+#include "map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+static long calls = 0;
+
+struct counting_less
+{
+	bool operator()(const std::string &a, const std::string &b) const
+	{
+		++calls;
+		return a < b;
+	}
+};
+struct counting_three_way : counting_less
+{
+	int three_way(const std::string &a, const std::string &b) const
+	{
+		++calls;
+		return a.compare(b);
+	}
+};
+
+template <class C>
+void bench(const char *name)
+{
+	const int n = 200000;
+	const int rounds = 10;
+	std::mt19937 rng(9);
+	std::vector<std::string> keys;
+	for (int i = 0; i < n; ++i)
+	{
+		keys.push_back("config/section/entry/" + std::to_string(rng()));
+	}
+	sjtu::map<std::string, int, C> m;
+	calls = 0;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		m.insert(sjtu::pair<const std::string, int>(keys[i], i));
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	long inserted = calls;
+	std::shuffle(keys.begin(), keys.end(), rng);
+	calls = 0;
+	long long s = 0;
+	std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; ++r)
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			s += m.find(keys[i])->second;
+		}
+	}
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	printf("%-10s insert %.1f cmp/op %.0f ms | find %.1f cmp/op %.0f ms (%lld)\n", name, double(inserted) / n,
+		   std::chrono::duration<double, std::milli>(t1 - t0).count(), double(calls) / (double(rounds) * n),
+		   std::chrono::duration<double, std::milli>(t3 - t2).count(), s);
+}
+
+int main()
+{
+	bench<counting_less>("less");
+	bench<counting_three_way>("three_way");
+	return 0;
+}
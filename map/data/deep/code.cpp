@@ -0,0 +1,62 @@
+#include "map.hpp"
+#include <iostream>
+
+// 大树上的迭代式插入、删除、拷贝和清空：不依赖递归深度，
+// 拷贝所用的定长栈按 AVL 的高度上界取，顺序、逆序、交错插入建出的树都放得下
+
+typedef sjtu::map<int, int> map_type;
+
+long long checksum(const map_type &m) {
+	long long s = 0;
+	int prev = -1;
+	bool sorted = true;
+	for (map_type::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		sorted = sorted && it->first > prev;
+		prev = it->first;
+		s = s * 31 + it->first + it->second;
+		s %= 1000000007;
+	}
+	return sorted ? s : -1;
+}
+
+void TestPattern(const char *name, int n, int (*key)(int, int)) {
+	map_type m;
+	for (int i = 0; i < n; ++i) {
+		m[key(i, n)] = i;
+	}
+	map_type c(m);
+	map_type d;
+	d = c;
+	std::cout << name << ": " << m.size() << " " << checksum(m) << " " << (checksum(c) == checksum(m)) << " "
+			  << (checksum(d) == checksum(m)) << std::endl;
+	for (int i = 0; i < n; i += 2) {
+		c.erase(c.find(key(i, n)));
+	}
+	map_type e(c);
+	std::cout << name << " after erase: " << e.size() << " " << checksum(e) << " " << (checksum(c) == checksum(e)) << std::endl;
+	m.clear();
+	d = e;
+	std::cout << m.size() << " " << d.size() << std::endl;
+}
+
+int ascending(int i, int) {
+	return i;
+}
+int descending(int i, int n) {
+	return n - 1 - i;
+}
+int zigzag(int i, int n) {
+	return i % 2 == 0 ? i / 2 : n - 1 - i / 2;
+}
+int strided(int i, int n) {
+	return static_cast<int>(static_cast<long long>(i) * 1000003 % n);
+}
+
+int main() {
+	const int n = 1 << 19;
+	TestPattern("ascending", n, ascending);
+	TestPattern("descending", n, descending);
+	TestPattern("zigzag", n, zigzag);
+	TestPattern("strided", n, strided);
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include "map.hpp"
+#include <iostream>
+#include <string>
+
+// erase(iterator) 直接从迭代器所指节点删除：别的 map 的迭代器、end() 和默认构造的迭代器都抛出 invalid_iterator，
+// 被拒绝的调用不改变任何一方
+
+template <class Map>
+void expect_invalid(const char *what, Map &m, typename Map::iterator it) {
+	try {
+		m.erase(it);
+		std::cout << what << ": erased" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << what << ": invalid_iterator" << std::endl;
+	}
+}
+
+template <class Map>
+void print(const Map &m) {
+	std::cout << m.size() << ":";
+	for (typename Map::const_iterator it = m.cbegin(); it != m.cend(); ++it) {
+		std::cout << " " << it->first;
+	}
+	std::cout << std::endl;
+}
+
+template <class Map>
+void TestErase(const char *name) {
+	std::cout << "Testing " << name << "..." << std::endl;
+	Map a;
+	Map b;
+	for (int i = 0; i < 10; ++i) {
+		a[i] = std::to_string(i);
+		b[i] = std::to_string(i * 10);
+	}
+	expect_invalid("iterator of another map", a, b.find(3));
+	expect_invalid("end()", a, a.end());
+	expect_invalid("default iterator", a, typename Map::iterator());
+	Map c(a);
+	expect_invalid("iterator of a copy", a, c.begin());
+	print(a);
+	print(b);
+
+	a.erase(a.begin());
+	a.erase(--a.end());
+	a.erase(a.find(5));
+	print(a);
+	typename Map::iterator it = a.begin();
+	while (it != a.end()) {
+		typename Map::iterator victim = it++;
+		if (victim->first % 2 == 0) {
+			a.erase(victim);
+		}
+	}
+	print(a);
+	a[4] = "again";
+	typename Map::iterator back = a.end();
+	--back;
+	a.erase(back);
+	print(a);
+	while (!a.empty()) {
+		a.erase(a.begin());
+	}
+	print(a);
+	expect_invalid("end() of empty map", a, a.end());
+}
+
+int main() {
+	TestErase<sjtu::map<int, std::string>>("parent_links");
+	TestErase<sjtu::map<int, std::string, std::less<int>, sjtu::threaded_links>>("threaded_links");
+	return 0;
+}
@@ -0,0 +1,82 @@
+#include "map.hpp"
+#include <iostream>
+#include <string>
+
+// 头结点：begin()、end()--、rbegin() 都是 O(1)，越界移动抛出 invalid_iterator
+
+typedef sjtu::map<int, std::string> map_type;
+
+template <class F>
+void expect_throw(const char *what, F f) {
+	try {
+		f();
+		std::cout << what << ": no exception" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << what << ": invalid_iterator" << std::endl;
+	} catch (...) {
+		std::cout << what << ": other exception" << std::endl;
+	}
+}
+
+void TestEmpty() {
+	std::cout << "Testing empty map..." << std::endl;
+	map_type m;
+	const map_type &cm = m;
+	std::cout << (m.begin() == m.end()) << " " << (m.rbegin() == m.rend()) << " " << (cm.cbegin() == cm.cend()) << std::endl;
+	expect_throw("--end", [&]() { map_type::iterator it = m.end(); --it; });
+	expect_throw("++end", [&]() { map_type::iterator it = m.end(); ++it; });
+}
+
+void TestEnds() {
+	std::cout << "Testing begin/end/rbegin..." << std::endl;
+	map_type m;
+	for (int i = 0; i < 1000; ++i) {
+		int k = i * 7919 % 1000;
+		m[k] = std::to_string(k);
+		map_type::iterator last = m.end();
+		--last;
+		if (i % 200 == 0) {
+			std::cout << m.begin()->first << " " << last->first << " " << m.rbegin()->first << std::endl;
+		}
+	}
+	map_type::iterator it = m.end();
+	for (int i = 0; i < 5; ++i) {
+		--it;
+		std::cout << it->first << " ";
+	}
+	std::cout << std::endl;
+	expect_throw("--begin", [&]() { map_type::iterator b = m.begin(); --b; });
+	expect_throw("++end", [&]() { map_type::iterator e = m.end(); e++; });
+}
+
+void TestStable() {
+	std::cout << "Testing iterators across insert/erase..." << std::endl;
+	map_type m;
+	m[500] = "mid";
+	map_type::iterator mid = m.find(500);
+	map_type::iterator end = m.end();
+	for (int i = 0; i < 1000; ++i) {
+		if (i != 500) {
+			m[i] = "x";
+		}
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		if (i != 500) {
+			m.erase(m.find(i));
+		}
+	}
+	std::cout << mid->first << " " << mid->second << " " << (end == m.end()) << " " << m.size() << std::endl;
+	--end;
+	std::cout << end->first << std::endl;
+	while (m.size() > 1) {
+		m.erase(m.begin() == mid ? --m.end() : m.begin());
+	}
+	std::cout << m.begin()->first << " " << m.rbegin()->first << " " << (++m.begin() == m.end()) << std::endl;
+}
+
+int main() {
+	TestEmpty();
+	TestEnds();
+	TestStable();
+	return 0;
+}
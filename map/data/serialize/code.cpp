@@ -0,0 +1,137 @@
+#include "map.hpp"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+// 存档：读回的树与原树内容一致且可继续增删，从不可定位的流读入，
+// 键不升序、个数伪造、数据截断的存档被拒绝，且读档失败不改动原 map
+
+typedef sjtu::map<int, std::string> map_type;
+
+// 只能顺序读取的流缓冲，模拟管道
+struct pipe_buffer : std::streambuf {
+	std::string s;
+	size_t p;
+	explicit pipe_buffer(const std::string &s) : s(s), p(0) {}
+	int underflow() override {
+		if (p >= s.size()) {
+			return traits_type::eof();
+		}
+		setg(&s[p], &s[p], &s[p] + 1);
+		++p;
+		return static_cast<unsigned char>(s[p - 1]);
+	}
+};
+
+bool same(const map_type &m, const std::map<int, std::string> &r) {
+	if (m.size() != r.size()) {
+		return false;
+	}
+	std::map<int, std::string>::const_iterator j = r.begin();
+	for (map_type::const_iterator it = m.cbegin(); it != m.cend(); ++it, ++j) {
+		if (it->first != j->first || it->second != j->second) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRoundTrip() {
+	std::cout << "Testing round trip..." << std::endl;
+	std::mt19937 rng(14);
+	map_type m;
+	std::map<int, std::string> r;
+	for (int i = 0; i < 100000; ++i) {
+		int k = rng() % 1000000;
+		m[k] = std::to_string(i);
+		r[k] = std::to_string(i);
+	}
+	std::stringstream ss;
+	m.save(ss);
+	map_type w;
+	w[-1] = "old";
+	w.load(ss);
+	std::cout << w.size() << " " << same(w, r) << " " << w.count(-1) << std::endl;
+	for (int i = 0; i < 50000; ++i) {
+		int k = rng() % 1000000;
+		if (rng() % 2) {
+			w[k] = "new";
+			r[k] = "new";
+		} else if (w.count(k)) {
+			w.erase(w.find(k));
+			r.erase(k);
+		}
+	}
+	std::cout << w.size() << " " << same(w, r) << std::endl;
+
+	std::stringstream ss2;
+	map_type().save(ss2);
+	w.load(ss2);
+	std::cout << w.size() << " " << (w.begin() == w.end()) << std::endl;
+}
+
+void TestPipe() {
+	std::cout << "Testing non-seekable stream..." << std::endl;
+	map_type m;
+	for (int i = 0; i < 3000; ++i) {
+		m[i] = std::string(i % 50, 'x');
+	}
+	std::stringstream ss;
+	m.save(ss);
+	pipe_buffer pb(ss.str());
+	std::istream in(&pb);
+	map_type w;
+	w.load(in);
+	std::cout << w.size() << " " << w.at(2999).size() << " " << (--w.end())->first << std::endl;
+}
+
+void expect_reject(const char *name, const std::string &blob, bool pipe) {
+	map_type m;
+	m[1] = "a";
+	m[2] = "b";
+	std::stringstream ss(blob);
+	pipe_buffer pb(blob);
+	std::istream in(&pb);
+	try {
+		m.load(pipe ? in : static_cast<std::istream &>(ss));
+		std::cout << name << ": accepted" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << name << ": runtime_error, size " << m.size() << " " << m.at(2) << std::endl;
+	}
+}
+
+void TestReject() {
+	std::cout << "Testing corrupted archives..." << std::endl;
+	sjtu::map<int, std::string, std::greater<int>> desc;
+	for (int i = 0; i < 10; ++i) {
+		desc[i] = "d";
+	}
+	std::stringstream ss;
+	desc.save(ss);
+	expect_reject("keys not ascending", ss.str(), false);
+
+	std::stringstream forged;
+	sjtu::write_archive_header(forged, 'M', false, 0, 1ULL << 40);
+	expect_reject("huge count", forged.str(), false);
+	expect_reject("huge count from pipe", forged.str(), true);
+
+	map_type m;
+	for (int i = 0; i < 100; ++i) {
+		m[i] = "v";
+	}
+	std::stringstream full;
+	m.save(full);
+	std::string blob = full.str();
+	expect_reject("truncated", blob.substr(0, blob.size() - 3), false);
+	expect_reject("wrong kind", blob.substr(0, 8) + "V" + blob.substr(9), false);
+}
+
+int main() {
+	TestRoundTrip();
+	TestPipe();
+	TestReject();
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include "map.hpp"
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+// threaded_links：每个节点带中序前驱、后继指针，迭代器正反向移动都是 O(1)；
+// 随机增删后与 std::map 逐个比对两个方向的遍历结果
+
+typedef sjtu::map<int, std::string, std::less<int>, sjtu::threaded_links> map_type;
+
+bool same_forward(const map_type &m, const std::map<int, std::string> &ref) {
+	std::map<int, std::string>::const_iterator r = ref.begin();
+	for (map_type::const_iterator it = m.cbegin(); it != m.cend(); ++it, ++r) {
+		if (r == ref.end() || it->first != r->first || it->second != r->second) {
+			return false;
+		}
+	}
+	return r == ref.end();
+}
+
+bool same_backward(map_type &m, const std::map<int, std::string> &ref) {
+	std::map<int, std::string>::const_reverse_iterator r = ref.rbegin();
+	map_type::iterator it = m.end();
+	while (it != m.begin()) {
+		--it;
+		if (r == ref.rend() || it->first != r->first) {
+			return false;
+		}
+		++r;
+	}
+	return r == ref.rend();
+}
+
+void TestRandom() {
+	std::cout << "Testing threaded iteration against std::map..." << std::endl;
+	std::mt19937 rng(2022);
+	map_type m;
+	std::map<int, std::string> ref;
+	for (int round = 0; round < 10; ++round) {
+		for (int step = 0; step < 5000; ++step) {
+			int k = rng() % 3000;
+			if (rng() % 3 != 0) {
+				m[k] = std::to_string(step);
+				ref[k] = std::to_string(step);
+			} else if (ref.count(k)) {
+				m.erase(m.find(k));
+				ref.erase(k);
+			}
+		}
+		std::cout << m.size() << " " << same_forward(m, ref) << " " << same_backward(m, ref) << std::endl;
+	}
+}
+
+void TestCopyAndReverse() {
+	std::cout << "Testing copies and reverse iterators..." << std::endl;
+	map_type m;
+	for (int i = 0; i < 20; ++i) {
+		m[i * i % 37] = std::to_string(i);
+	}
+	map_type c(m);
+	m.clear();
+	for (map_type::reverse_iterator it = c.rbegin(); it != c.rend(); ++it) {
+		std::cout << it->first << " ";
+	}
+	std::cout << std::endl;
+	map_type d;
+	d[100] = "x";
+	d = c;
+	map_type::iterator it = d.find(16);
+	map_type::iterator prev = it;
+	--prev;
+	map_type::iterator next = it;
+	++next;
+	std::cout << prev->first << " " << it->first << " " << next->first << std::endl;
+	d.erase(it);
+	--next;
+	std::cout << next->first << " " << d.size() << std::endl;
+}
+
+int main() {
+	TestRandom();
+	TestCopyAndReverse();
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "map.hpp"
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+// 三路比较：比较器提供 three_way 时查找每层只比较一次且不再调用 operator()；
+// 上下界查询在三种比较器、两种链接方式下都与 std::map 一致
+
+long less_calls = 0;
+long three_way_calls = 0;
+
+struct counting_less {
+	bool operator()(const std::string &a, const std::string &b) const {
+		++less_calls;
+		return a < b;
+	}
+};
+struct counting_three_way : counting_less {
+	int three_way(const std::string &a, const std::string &b) const {
+		++three_way_calls;
+		return a.compare(b);
+	}
+};
+
+std::string key_of(int x) {
+	return "entry/" + std::to_string(x * 3);
+}
+
+template <class C>
+void TestCalls(const char *name) {
+	sjtu::map<std::string, int, C> m;
+	for (int i = 0; i < 4096; ++i) {
+		m[key_of(i * 2897 % 4096)] = i;
+	}
+	less_calls = three_way_calls = 0;
+	long found = 0;
+	for (int i = 0; i < 4096; ++i) {
+		found += m.count(key_of(i));
+		found += m.count(key_of(i) + "x");
+	}
+	// 4096 个节点的 AVL 树高不超过 17
+	double per_lookup = double(less_calls + three_way_calls) / 8192;
+	std::cout << name << ": found " << found << ", operator() used " << (less_calls != 0)
+			  << ", three_way used " << (three_way_calls != 0) << ", within height " << (per_lookup <= 18) << std::endl;
+}
+
+template <class M, class K>
+void TestBounds(const char *name, K (*make)(int)) {
+	std::mt19937 rng(25);
+	M m;
+	std::map<K, int> ref;
+	int mismatches = 0;
+	for (int step = 0; step < 20000; ++step) {
+		K k = make(rng() % 2000);
+		int op = rng() % 4;
+		if (op == 0) {
+			m[k] = step;
+			ref[k] = step;
+		} else if (op == 1) {
+			if (ref.count(k)) {
+				m.erase(m.find(k));
+				ref.erase(k);
+			}
+		} else {
+			const M &cm = m;
+			typename M::const_iterator lb = cm.lower_bound(k);
+			typename std::map<K, int>::iterator rlb = ref.lower_bound(k);
+			if ((lb == cm.cend()) != (rlb == ref.end()) || (rlb != ref.end() && lb->first != rlb->first)) {
+				++mismatches;
+			}
+			typename M::iterator ub = m.upper_bound(k);
+			typename std::map<K, int>::iterator rub = ref.upper_bound(k);
+			if ((ub == m.end()) != (rub == ref.end()) || (rub != ref.end() && ub->first != rub->first)) {
+				++mismatches;
+			}
+		}
+	}
+	std::cout << name << ": size " << m.size() << ", mismatches " << mismatches << std::endl;
+}
+
+int make_int(int x) {
+	return x * 3;
+}
+
+int main() {
+	std::cout << "Testing comparator calls..." << std::endl;
+	std::cout << sjtu::has_three_way<std::less<int>, int>::value << " "
+			  << sjtu::has_three_way<sjtu::three_way_less<int>, int>::value << " "
+			  << sjtu::has_three_way<counting_three_way, std::string>::value << std::endl;
+	TestCalls<counting_less>("less");
+	TestCalls<counting_three_way>("three_way");
+
+	std::cout << "Testing lower_bound/upper_bound..." << std::endl;
+	TestBounds<sjtu::map<int, int>>("int less", make_int);
+	TestBounds<sjtu::map<int, int, sjtu::three_way_less<int>>>("int three_way", make_int);
+	TestBounds<sjtu::map<int, int, sjtu::three_way_less<int>, sjtu::threaded_links>>("int three_way threaded", make_int);
+	TestBounds<sjtu::map<std::string, int>>("string less", key_of);
+	TestBounds<sjtu::map<std::string, int, sjtu::three_way_less<std::string>>>("string three_way", key_of);
+	TestBounds<sjtu::map<std::string, int, std::less<std::string>, sjtu::threaded_links>>("string less threaded", key_of);
+	return 0;
+}
@@ -3,19 +3,99 @@
 
 #include <functional>
 #include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<compare>) && defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
+#define SJTU_HAS_SPACESHIP 1
+#endif
+#endif
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "serialize.hpp"
 
 // 参考资料：https://www.cnblogs.com/komet/p/13736468.html
 // https://www.cnblogs.com/leipDao/p/10097001.html
 // github repository from ACMClassCourse-2022
 namespace sjtu
 {
+    // 迭代方式：parent_links 沿父指针回溯求前驱后继，均摊 O(1)、最坏 O(log n)；
+    // threaded_links 在每个节点另存中序的 prev/next，自增自减最坏 O(1)，每个节点多两个指针
+    struct parent_links
+    {
+        static const bool threaded = false;
+    };
+    struct threaded_links
+    {
+        static const bool threaded = true;
+    };
+
+    // 节点中的中序链，头结点也在链上，整条链首尾相接
+    template <class N, bool Threaded>
+    struct inorder_links
+    {
+    };
+    template <class N>
+    struct inorder_links<N, true>
+    {
+        N *prev = nullptr;
+        N *next = nullptr;
+    };
+
+    // 三路比较：比较器若提供 three_way(a, b)（a < b 时为负、相等为 0、a > b 时为正），
+    // map 的查找、插入和上下界查询每层只调用一次 three_way，遇到相等立即停止；
+    // 否则每层只调用一次 compare，走到底后再补一次比较判断相等
+    template <class C, class K, class = void>
+    struct has_three_way : std::false_type
+    {
+    };
+    template <class C, class K>
+    struct has_three_way<C, K, decltype(void(std::declval<const C &>().three_way(std::declval<const K &>(), std::declval<const K &>())))>
+        : std::true_type
+    {
+    };
+
+    // 带 three_way 的 less：C++20 下 Key 支持 <=> 时用 <=>，否则退化为两次 <
+    template <class Key>
+    struct three_way_less
+    {
+        bool operator()(const Key &a, const Key &b) const
+        {
+            return a < b;
+        }
+        int three_way(const Key &a, const Key &b) const
+        {
+#ifdef SJTU_HAS_SPACESHIP
+            if constexpr (std::three_way_comparable<Key>)
+            {
+                auto c = a <=> b;
+                return c < 0 ? -1 : (c > 0 ? 1 : 0);
+            }
+#endif
+            return a < b ? -1 : (b < a ? 1 : 0);
+        }
+    };
+    // 字符串：compare 一次逐字节比较即得三路结果
+    template <class Ch, class Tr, class A>
+    struct three_way_less<std::basic_string<Ch, Tr, A>>
+    {
+        bool operator()(const std::basic_string<Ch, Tr, A> &a, const std::basic_string<Ch, Tr, A> &b) const
+        {
+            return a < b;
+        }
+        int three_way(const std::basic_string<Ch, Tr, A> &a, const std::basic_string<Ch, Tr, A> &b) const
+        {
+            return a.compare(b);
+        }
+    };
 
     template <
         class Key,
         class T,
-        class Compare = std::less<Key>>
+        class Compare = std::less<Key>,
+        class Links = parent_links>
     class map
     {
     public:
@@ -23,21 +103,35 @@ namespace sjtu
         class iterator;
 
     private:
-        struct Node
+        // 头结点（哨兵）的 h 为 0 且不构造 data，实际节点的 h 至少为 1。
+        // 头结点的 f 指向根、ls 指向最小节点、rs 指向最大节点，根的 f 指向头结点；end() 即头结点
+        struct Node : inorder_links<Node, Links::threaded>
         {
-            value_type data;
+            union
+            {
+                value_type data;
+            };
             Node *ls;
             Node *rs;
             Node *f;
             size_t h;
 
-            Node() : data(0), ls(nullptr), rs(nullptr), f(nullptr), h(0) {}
-            Node(const value_type &data_, Node *l = nullptr, Node *r = nullptr, Node *f_ = nullptr, size_t h_ = 0) : data(data_), ls(l), rs(r), f(f_), h(h_) {}
-            Node(const Node &other) : data(other.data), ls(other.ls), rs(other.rs), f(other.f), h(other.h) {}
+            Node() : ls(nullptr), rs(nullptr), f(nullptr), h(0) {}
+            Node(const value_type &data_, Node *l = nullptr, Node *r = nullptr, Node *f_ = nullptr, size_t h_ = 1) : data(data_), ls(l), rs(r), f(f_), h(h_) {}
+            ~Node()
+            {
+                if (h != 0)
+                {
+                    data.~value_type();
+                }
+            }
         };
 
+        typedef std::integral_constant<bool, Links::threaded> threaded_tag;
+        typedef std::integral_constant<bool, has_three_way<Compare, Key>::value> three_way_tag;
+
         size_t Size;
-        Node *root;
+        Node header;     // 头结点，root 即 header.f
         Compare compare; // 减少函数调用开销
 
         int max(int a, int b)
@@ -57,44 +151,291 @@ namespace sjtu
             return max(get_h(a->ls), get_h(a->rs)) + 1;
         }
 
-        Node *copy_Node(Node *a)
+        // 复制以 a 为根的子树：用定长的栈按先序复制，不递归；AVL 的高度不超过 1.45 log2(n)，栈不会溢出。
+        // 复制失败时释放已复制的部分
+        Node *copy_Node(const Node *a)
         {
             if (a == nullptr)
             {
                 return nullptr;
             }
-            Node *new_node = new Node(a->data);
-            new_node->h = a->h;
-            new_node->ls = copy_Node(a->ls);
-            new_node->rs = copy_Node(a->rs);
-            if (new_node->ls != nullptr)
+            const size_t max_stack = 2 * sizeof(size_t) * 8;
+            const Node *src[max_stack];
+            Node *dst[max_stack];
+            size_t n = 0;
+            Node *top = new Node(a->data, nullptr, nullptr, nullptr, a->h);
+            src[n] = a;
+            dst[n] = top;
+            ++n;
+            try
             {
-                new_node->ls->f = new_node;
+                while (n != 0)
+                {
+                    --n;
+                    const Node *s = src[n];
+                    Node *d = dst[n];
+                    if (s->rs != nullptr)
+                    {
+                        d->rs = new Node(s->rs->data, nullptr, nullptr, d, s->rs->h);
+                        src[n] = s->rs;
+                        dst[n] = d->rs;
+                        ++n;
+                    }
+                    if (s->ls != nullptr)
+                    {
+                        d->ls = new Node(s->ls->data, nullptr, nullptr, d, s->ls->h);
+                        src[n] = s->ls;
+                        dst[n] = d->ls;
+                        ++n;
+                    }
+                }
             }
-            if (new_node->rs != nullptr)
+            catch (...)
             {
-                new_node->rs->f = new_node;
+                delete_Node(top);
+                throw;
             }
-            return new_node;
+            return top;
         }
+        // 释放以 a 为根的子树：一路向下找叶子，删掉后回到父节点，不用递归
         void delete_Node(Node *a)
         {
             if (a == nullptr)
             {
                 return;
             }
-            delete_Node(a->ls);
-            delete_Node(a->rs);
-            delete a;
+            Node *top = a;
+            while (true)
+            {
+                if (a->ls != nullptr)
+                {
+                    a = a->ls;
+                }
+                else if (a->rs != nullptr)
+                {
+                    a = a->rs;
+                }
+                else
+                {
+                    Node *f = a->f;
+                    delete a;
+                    if (a == top)
+                    {
+                        return;
+                    }
+                    (f->ls == a ? f->ls : f->rs) = nullptr;
+                    a = f;
+                }
+            }
         }
 
-        Node *find_Node(const Key &key)
+        // 父节点中指向 x 的那个指针；x 为根时是头结点的 f
+        Node *&link_of(Node *x)
+        {
+            Node *f = x->f;
+            if (f->h == 0)
+            {
+                return f->f;
+            }
+            return f->ls == x ? f->ls : f->rs;
+        }
+
+        // 中序后继，没有时返回头结点；要求 p 不是头结点
+        template <class P>
+        static P next_Node(P p, std::false_type)
         {
-            Node *p = root;
-            while (p != nullptr && (compare(p->data.first, key) || compare(key, p->data.first)))
+            if (p->rs != nullptr) // 右子树的最左节点
+            {
+                p = p->rs;
+                while (p->ls != nullptr)
+                {
+                    p = p->ls;
+                }
+                return p;
+            }
+            // 向上回溯，直到节点为父节点的左子节点
+            P ff = p->f;
+            while (ff->h != 0 && ff->rs == p)
+            {
+                p = ff;
+                ff = ff->f;
+            }
+            return ff;
+        }
+        template <class P>
+        static P next_Node(P p, std::true_type)
+        {
+            return p->next;
+        }
+        // 中序前驱，没有时返回头结点；p 为头结点时返回最大节点，要求 map 非空
+        template <class P>
+        static P prev_Node(P p, std::false_type)
+        {
+            if (p->h == 0)
+            {
+                return p->rs;
+            }
+            if (p->ls != nullptr) // 左子树的最右节点
+            {
+                p = p->ls;
+                while (p->rs != nullptr)
+                {
+                    p = p->rs;
+                }
+                return p;
+            }
+            // 向上回溯，直到节点为父节点的右子节点
+            P ff = p->f;
+            while (ff->h != 0 && ff->ls == p)
+            {
+                p = ff;
+                ff = ff->f;
+            }
+            return ff;
+        }
+        template <class P>
+        static P prev_Node(P p, std::true_type)
+        {
+            return p->prev;
+        }
+
+        // 新节点 t 已挂到父节点下，把它接入中序链
+        void thread_in(Node *, std::false_type) {}
+        void thread_in(Node *t, std::true_type)
+        {
+            Node *p = t->f;
+            if (p->h == 0)
+            {
+                t->prev = t->next = &header;
+            }
+            else if (p->ls == t)
+            {
+                t->next = p;
+                t->prev = p->prev;
+            }
+            else
+            {
+                t->prev = p;
+                t->next = p->next;
+            }
+            t->prev->next = t;
+            t->next->prev = t;
+        }
+        // 节点 t 即将删除，从中序链上摘下
+        void thread_out(Node *, std::false_type) {}
+        void thread_out(Node *t, std::true_type)
+        {
+            t->prev->next = t->next;
+            t->next->prev = t->prev;
+        }
+        // 按中序重建整条链，O(n)
+        void thread_all(std::false_type) {}
+        void thread_all(std::true_type)
+        {
+            Node *last = &header;
+            for (Node *p = header.ls; p != nullptr && p->h != 0; p = next_Node(p, std::false_type()))
+            {
+                p->prev = last;
+                last->next = p;
+                last = p;
+            }
+            last->next = &header;
+            header.prev = last;
+        }
+
+        // 整棵树换过之后，按根重新连好头结点
+        void link_header()
+        {
+            if (header.f == nullptr)
+            {
+                header.ls = header.rs = nullptr;
+                thread_all(threaded_tag());
+                return;
+            }
+            header.f->f = &header;
+            Node *p = header.f;
+            while (p->ls != nullptr)
+            {
+                p = p->ls;
+            }
+            header.ls = p;
+            p = header.f;
+            while (p->rs != nullptr)
+            {
+                p = p->rs;
+            }
+            header.rs = p;
+            thread_all(threaded_tag());
+        }
+
+        // 由升序排列的 nodes[l, r) 建出完全平衡的子树
+        Node *build_Node(Node **nodes, size_t l, size_t r, Node *father)
+        {
+            if (l == r)
+            {
+                return nullptr;
+            }
+            size_t mid = l + (r - l) / 2;
+            Node *t = nodes[mid];
+            t->f = father;
+            t->ls = build_Node(nodes, l, mid, t);
+            t->rs = build_Node(nodes, mid + 1, r, t);
+            t->h = update_h(t);
+            return t;
+        }
+
+        // 第一个不小于 key 的节点，没有时返回头结点
+        Node *lower_Node(const Key &key, std::false_type)
+        {
+            Node *p = header.f;
+            Node *cand = &header;
+            while (p != nullptr)
+            {
+                if (compare(p->data.first, key))
+                {
+                    p = p->rs;
+                }
+                else
+                {
+                    cand = p;
+                    p = p->ls;
+                }
+            }
+            return cand;
+        }
+        Node *lower_Node(const Key &key, std::true_type)
+        {
+            Node *p = header.f;
+            Node *cand = &header;
+            while (p != nullptr)
+            {
+                int c = compare.three_way(p->data.first, key);
+                if (c < 0)
+                {
+                    p = p->rs;
+                }
+                else
+                {
+                    cand = p;
+                    if (c == 0)
+                    {
+                        break;
+                    }
+                    p = p->ls;
+                }
+            }
+            return cand;
+        }
+        // 第一个大于 key 的节点，没有时返回头结点
+        Node *upper_Node(const Key &key, std::false_type)
+        {
+            Node *p = header.f;
+            Node *cand = &header;
+            while (p != nullptr)
             {
                 if (compare(key, p->data.first))
                 {
+                    cand = p;
                     p = p->ls;
                 }
                 else
@@ -102,12 +443,111 @@ namespace sjtu
                     p = p->rs;
                 }
             }
-            if (p == nullptr)
+            return cand;
+        }
+        Node *upper_Node(const Key &key, std::true_type)
+        {
+            Node *p = header.f;
+            Node *cand = &header;
+            while (p != nullptr)
+            {
+                int c = compare.three_way(key, p->data.first);
+                if (c < 0)
+                {
+                    cand = p;
+                    p = p->ls;
+                }
+                else if (c == 0) // 相等时答案是它的后继
+                {
+                    return p->rs != nullptr ? next_Node(p, std::false_type()) : cand;
+                }
+                else
+                {
+                    p = p->rs;
+                }
+            }
+            return cand;
+        }
+
+        Node *find_Node(const Key &key, std::false_type)
+        {
+            Node *p = lower_Node(key, std::false_type());
+            if (p->h == 0 || compare(key, p->data.first))
             {
                 return nullptr;
             }
             return p;
         }
+        Node *find_Node(const Key &key, std::true_type)
+        {
+            Node *p = header.f;
+            while (p != nullptr)
+            {
+                int c = compare.three_way(key, p->data.first);
+                if (c == 0)
+                {
+                    return p;
+                }
+                p = c < 0 ? p->ls : p->rs;
+            }
+            return nullptr;
+        }
+        Node *find_Node(const Key &key)
+        {
+            return find_Node(key, three_way_tag());
+        }
+
+        // 自顶向下找插入位置：key 已存在时返回该节点，否则 link 为应挂新节点的指针、father 为其父，
+        // leftmost/rightmost 记录是否一路向左/向右，据此维护最小/最大节点
+        Node *insert_slot(const Key &key, Node *&father, Node **&link, bool &leftmost, bool &rightmost, std::false_type)
+        {
+            Node *cand = nullptr; // 最后一个向右走过的节点，唯一可能与 key 相等的节点
+            while (*link != nullptr)
+            {
+                Node *t = *link;
+                if (compare(key, t->data.first))
+                {
+                    link = &t->ls;
+                    rightmost = false;
+                }
+                else
+                {
+                    cand = t;
+                    link = &t->rs;
+                    leftmost = false;
+                }
+                father = t;
+            }
+            if (cand != nullptr && !compare(cand->data.first, key))
+            {
+                return cand;
+            }
+            return nullptr;
+        }
+        Node *insert_slot(const Key &key, Node *&father, Node **&link, bool &leftmost, bool &rightmost, std::true_type)
+        {
+            while (*link != nullptr)
+            {
+                Node *t = *link;
+                int c = compare.three_way(key, t->data.first);
+                if (c == 0)
+                {
+                    return t;
+                }
+                if (c < 0)
+                {
+                    link = &t->ls;
+                    rightmost = false;
+                }
+                else
+                {
+                    link = &t->rs;
+                    leftmost = false;
+                }
+                father = t;
+            }
+            return nullptr;
+        }
 
         void LL(Node *&x)
         {
@@ -150,289 +590,169 @@ namespace sjtu
             RR(x);
         }
 
-        pair<iterator, bool> insert_Node(const value_type &value, Node *&t, Node *&father)
+        // 插入后自新节点的父亲 p 向上更新高度：高度不变即可停止，失衡时旋转一次即恢复原高度
+        void insert_fixup(Node *p)
         {
-            if (t == nullptr)
-            {
-                t = new Node(value, nullptr, nullptr, father, 1);
-                iterator it(t, this);
-                return pair<iterator, bool>(it, true);
-            }
-            else if (compare(value.first, t->data.first))
+            for (; p->h != 0; p = p->f)
             {
-                father = t;
-                pair<iterator, bool> tmp(insert_Node(value, t->ls, father));
-                if (tmp.second && balance(t) == 2)
+                int b = balance(p);
+                if (b == 2)
                 {
-                    if (compare(value.first, t->ls->data.first))
+                    if (balance(p->ls) > 0)
                     {
-                        LL(t);
+                        LL(link_of(p));
                     }
                     else
                     {
-                        LR(t);
+                        LR(link_of(p));
                     }
+                    return;
                 }
-                t->h = update_h(t);
-                return tmp;
-            }
-            else if (compare(t->data.first, value.first))
-            {
-                father = t;
-                pair<iterator, bool> tmp(insert_Node(value, t->rs, father));
-                if (tmp.second && balance(t) == -2)
+                if (b == -2)
                 {
-                    if (compare(t->rs->data.first, value.first))
+                    if (balance(p->rs) < 0)
                     {
-                        RR(t);
+                        RR(link_of(p));
                     }
                     else
                     {
-                        RL(t);
+                        RL(link_of(p));
                     }
+                    return;
                 }
-                t->h = update_h(t);
-                return tmp;
-            }
-            else // 插入失败
-            {
-                iterator it(t, this);
-                return pair<iterator, bool>(it, false);
+                size_t h = update_h(p);
+                if (h == p->h)
+                {
+                    return;
+                }
+                p->h = h;
             }
         }
 
-        bool adjust(Node *&t, int SubTree)
+        // 删除后自 p 向上调整：旋转或更新高度后，子树高度不变即可停止
+        void remove_fixup(Node *p)
         {
-            if (SubTree) // 右子树删除，使右子树变矮
+            while (p->h != 0)
             {
-                if (balance(t) == 1)
-                {
-                    return true;
-                }
-                if (balance(t) == 0)
-                {
-                    --(t->h);
-                    return false;
-                }
-                if (balance(t->ls) < 0)
+                Node *f = p->f; // 旋转后子树新根的父亲仍是 f
+                size_t old_h = p->h;
+                Node *&t = link_of(p);
+                int b = balance(p);
+                if (b == 2)
                 {
-                    LR(t);
-                    return false;
+                    if (balance(p->ls) >= 0)
+                    {
+                        LL(t);
+                    }
+                    else
+                    {
+                        LR(t);
+                    }
                 }
-                LL(t);
-                if (balance(t) == 0)
+                else if (b == -2)
                 {
-                    return false;
+                    if (balance(p->rs) <= 0)
+                    {
+                        RR(t);
+                    }
+                    else
+                    {
+                        RL(t);
+                    }
                 }
                 else
                 {
-                    return true;
-                }
-            }
-            else
-            {
-                if (balance(t) == -1)
-                {
-                    return true;
+                    p->h = update_h(p);
                 }
-                if (balance(t) == 0)
+                if (t->h == old_h)
                 {
-                    --(t->h);
-                    return false;
-                }
-                if (balance(t->rs) > 0)
-                {
-                    RL(t);
-                    return false;
-                }
-                RR(t);
-                if (balance(t) == 0)
-                {
-                    return false;
-                }
-                else
-                {
-                    return true;
+                    return;
                 }
+                p = f;
             }
         }
-        bool remove(const Key &key, Node *&t)
+
+        // 交换 z 与其后继 y 在树中的位置（连同高度），y 为 z 右子树的最左节点；节点本身不动，迭代器不失效
+        void swap_Node(Node *z, Node *y)
         {
-            if (t == nullptr)
+            Node *zl = z->ls;
+            Node *zr = z->rs;
+            Node *yf = y->f;
+            Node *yr = y->rs;
+            size_t h = z->h;
+            z->h = y->h;
+            y->h = h;
+            link_of(z) = y;
+            y->f = z->f;
+            y->ls = zl;
+            zl->f = y;
+            if (zr == y)
             {
-                return true;
+                y->rs = z;
+                z->f = y;
             }
-            if (compare(key, t->data.first)) // 左子树删除
+            else
             {
-                if (remove(key, t->ls)) // 没有变矮
-                {
-                    return true;
-                }
-                return adjust(t, 0);
+                y->rs = zr;
+                zr->f = y;
+                yf->ls = z;
+                z->f = yf;
             }
-            else if (compare(t->data.first, key)) // 右子树删除
+            z->ls = nullptr;
+            z->rs = yr;
+            if (yr != nullptr)
             {
-                if (remove(key, t->rs)) // 没有变矮
-                {
-                    return true;
-                }
-                return adjust(t, 1);
+                yr->f = z;
             }
-            else // 根节点
+        }
+
+        // 从树中摘下并释放节点 z，再向上调整平衡；不做任何键比较
+        void remove_Node(Node *z)
+        {
+            if (z->ls != nullptr && z->rs != nullptr)
             {
-                if (t->ls == nullptr || t->rs == nullptr) // 叶或一子
+                Node *y = z->rs;
+                while (y->ls != nullptr)
                 {
-                    Node *old_node = t;
-                    t = (t->ls != nullptr) ? t->ls : t->rs;
-                    if (t != nullptr)
-                    {
-                        t->f = old_node->f;
-                    }
-                    if (old_node != nullptr)
-                    {
-                        delete (old_node);
-                    }
-                    return false;
-                }
-                else // 两个儿子
-                {
-                    Node *tmp = t->rs;
-                    while (tmp->ls != nullptr)
-                    {
-                        tmp = tmp->ls;
-                    }
-                    int tmp_h = tmp->h;
-                    tmp->h = t->h;
-                    t->h = tmp_h;
-                    if (tmp == t->rs) // 特殊交换
-                    {
-                        Node *father = t->f;
-                        Node *son_l = t->ls;
-                        Node *son_r = tmp->rs;
-                        t->f = tmp;
-                        t->ls = nullptr;
-                        t->rs = son_r;
-                        tmp->f = father;
-                        tmp->ls = son_l;
-                        tmp->rs = t;
-
-                        if (father != nullptr) // 处理老爹
-                        {
-                            if (father->ls == t)
-                            {
-                                father->ls = tmp;
-                            }
-                            else
-                            {
-                                father->rs = tmp;
-                            }
-                        }
-                        if (son_l != nullptr)
-                        {
-                            son_l->f = tmp;
-                        }
-                        if (son_r != nullptr)
-                        {
-                            son_r->f = t;
-                        }
-                        t = tmp;
-                    }
-                    else // 交换
-                    {
-                        Node *father = tmp->f;
-                        Node *son = tmp->rs;
-                        Node *father_ = t->f;
-                        Node *son_l = t->ls;
-                        Node *son_r = t->rs;
-
-                        tmp->f = father_;
-                        tmp->ls = son_l;
-                        tmp->rs = son_r;
-                        t->ls = nullptr;
-                        t->rs = son;
-                        t->f = father;
-                        if (son != nullptr)
-                        {
-                            son->f = t;
-                        }
-                        father->ls = t;
-                        if (son_l != nullptr)
-                        {
-                            son_l->f = tmp;
-                        }
-                        son_r->f = tmp;
-                        if (father_ != nullptr)
-                        {
-                            if (t == father_->ls)
-                            {
-                                father_->ls = tmp;
-                            }
-                            else
-                            {
-                                father_->rs = tmp;
-                            }
-                        }
-                        t = tmp;
-                    }
-                    if (remove(key, t->rs))
-                    {
-                        return true;
-                    }
-                    return adjust(t, 1);
+                    y = y->ls;
                 }
+                swap_Node(z, y);
             }
+            Node *p = z->f;
+            Node *child = (z->ls != nullptr) ? z->ls : z->rs;
+            link_of(z) = child;
+            if (child != nullptr)
+            {
+                child->f = p;
+            }
+            thread_out(z, threaded_tag());
+            delete z;
+            remove_fixup(p);
         }
 
     public:
         class const_iterator;
         class iterator
         {
-        private:
         public:
-            Node *pos;
-            const map *container;
-            bool flag = true; // end()
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename map::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef value_type *pointer;
+            typedef value_type &reference;
+
+            Node *pos; // 指向头结点时为 end()
+
         public:
-            iterator(Node *pos_ = nullptr, const map *container_ = nullptr, bool flag_ = true) : pos(pos_), container(container_), flag(flag_) {}
-            iterator(const iterator &other)
-            {
-                pos = other.pos;
-                container = other.container;
-                flag = other.flag;
-            }
+            iterator(Node *pos_ = nullptr) : pos(pos_) {}
 
             void increase()
             {
-                if (pos == nullptr)
+                if (pos == nullptr || pos->h == 0) // 空迭代器或 end()
                 {
                     throw invalid_iterator();
                 }
-                if (pos->rs != nullptr) // 右子树的最左节点
-                {
-                    Node *lls = pos->rs;
-                    while (lls->ls != nullptr)
-                    {
-                        lls = lls->ls;
-                    }
-                    pos = lls;
-                    return;
-                }
-                // 向上回溯，节点为父节点的左子节点
-                Node *ff = pos->f;
-                Node *cur = pos;
-                while (ff != nullptr)
-                {
-                    if (ff->rs == cur)
-                    {
-                        cur = ff;
-                        ff = ff->f;
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                pos = ff;
+                pos = next_Node(pos, threaded_tag()); // 最大节点的后继即头结点 end()
             }
             iterator operator++(int)
             {
@@ -450,48 +770,18 @@ namespace sjtu
             {
                 if (pos == nullptr)
                 {
-                    if (flag)
-                    {
-                        throw invalid_iterator();
-                    }
-                    else
-                    {
-                        Node *p = container->root;
-                        while (p->rs != nullptr)
-                        {
-                            p = p->rs;
-                        }
-                        pos = p;
-                        flag = true;
-                        return;
-                    }
+                    throw invalid_iterator();
                 }
-                if (pos->ls != nullptr) // 左子树不为空
+                if (pos->h == 0 && pos->rs == nullptr) // 空 map 的 end()
                 {
-                    Node *rrs = pos->ls;
-                    while (rrs->rs != nullptr)
-                    {
-                        rrs = rrs->rs;
-                    }
-                    pos = rrs;
-                    return;
+                    throw invalid_iterator();
                 }
-                // 左子树为空，向上回溯 该节点为父节点的右子节点
-                Node *ff = pos->f;
-                Node *cur = pos;
-                while (ff != nullptr)
+                Node *p = prev_Node(pos, threaded_tag());
+                if (p->h == 0) // begin() 之前
                 {
-                    if (ff->ls == cur)
-                    {
-                        cur = ff;
-                        ff = ff->f;
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    throw invalid_iterator();
                 }
-                pos = ff;
+                pos = p;
             }
             iterator operator--(int)
             {
@@ -511,11 +801,11 @@ namespace sjtu
             }
             bool operator==(const iterator &rhs) const
             {
-                return (pos == rhs.pos) && (container == rhs.container);
+                return pos == rhs.pos;
             }
             bool operator==(const const_iterator &rhs) const
             {
-                return (pos == rhs.pos) && (container == rhs.container);
+                return pos == rhs.pos;
             }
 
             bool operator!=(const iterator &rhs) const
@@ -535,57 +825,25 @@ namespace sjtu
         class const_iterator
         {
         public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename map::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const value_type *pointer;
+            typedef const value_type &reference;
+
             const Node *pos;
-            const map *container;
-            bool flag = true;
 
         public:
-            const_iterator(const Node *pos_ = nullptr, const map *container_ = nullptr, bool flag_ = true) : pos(pos_), container(container_), flag(flag_) {}
-            const_iterator(const const_iterator &other)
-            {
-                pos = other.pos;
-                container = other.container;
-                flag = other.flag;
-            }
-            const_iterator(const iterator &other)
-            {
-                pos = other.pos;
-                container = other.container;
-                flag = other.flag;
-            }
+            const_iterator(const Node *pos_ = nullptr) : pos(pos_) {}
+            const_iterator(const iterator &other) : pos(other.pos) {}
 
             void increase()
             {
-                if (pos == nullptr)
+                if (pos == nullptr || pos->h == 0)
                 {
                     throw invalid_iterator();
                 }
-                if (pos->rs != nullptr) // 右子树的最左节点
-                {
-                    const Node *lls = pos->rs;
-                    while (lls->ls != nullptr)
-                    {
-                        lls = lls->ls;
-                    }
-                    pos = lls;
-                    return;
-                }
-                // 向上回溯，节点为父节点的左子节点
-                const Node *ff = pos->f;
-                const Node *cur = pos;
-                while (ff != nullptr)
-                {
-                    if (ff->rs == cur)
-                    {
-                        cur = ff;
-                        ff = ff->f;
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                pos = ff;
+                pos = next_Node(pos, threaded_tag()); // 最大节点的后继即头结点 end()
             }
             const_iterator operator++(int)
             {
@@ -603,48 +861,18 @@ namespace sjtu
             {
                 if (pos == nullptr)
                 {
-                    if (flag)
-                    {
-                        throw invalid_iterator();
-                    }
-                    else
-                    {
-                        Node *p = container->root;
-                        while (p->rs != nullptr)
-                        {
-                            p = p->rs;
-                        }
-                        pos = p;
-                        flag = true;
-                        return;
-                    }
+                    throw invalid_iterator();
                 }
-                if (pos->ls != nullptr) // 左子树不为空
+                if (pos->h == 0 && pos->rs == nullptr) // 空 map 的 end()
                 {
-                    const Node *rrs = pos->ls;
-                    while (rrs->rs != nullptr)
-                    {
-                        rrs = rrs->rs;
-                    }
-                    pos = rrs;
-                    return;
+                    throw invalid_iterator();
                 }
-                // 左子树为空，向上回溯 该节点为父节点的右子节点
-                const Node *ff = pos->f;
-                const Node *cur = pos;
-                while (ff != nullptr)
+                const Node *p = prev_Node(pos, threaded_tag());
+                if (p->h == 0) // begin() 之前
                 {
-                    if (ff->ls == cur)
-                    {
-                        cur = ff;
-                        ff = ff->f;
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    throw invalid_iterator();
                 }
-                pos = ff;
+                pos = p;
             }
             const_iterator operator--(int)
             {
@@ -664,11 +892,11 @@ namespace sjtu
             }
             bool operator==(const iterator &rhs) const
             {
-                return (pos == rhs.pos) && (container == rhs.container);
+                return pos == rhs.pos;
             }
             bool operator==(const const_iterator &rhs) const
             {
-                return (pos == rhs.pos) && (container == rhs.container);
+                return pos == rhs.pos;
             }
 
             bool operator!=(const iterator &rhs) const
@@ -685,15 +913,18 @@ namespace sjtu
                 return const_cast<value_type *>(&(pos->data));
             }
         };
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
         map()
         {
-            root = nullptr;
             Size = 0;
+            link_header();
         }
         map(const map &other)
         {
-            root = copy_Node(other.root);
+            header.f = copy_Node(other.header.f);
+            link_header();
             Size = other.Size;
         }
         map &operator=(const map &other)
@@ -702,15 +933,16 @@ namespace sjtu
             {
                 return *this;
             }
-            delete_Node(root);
-            root = copy_Node(other.root);
+            delete_Node(header.f);
+            header.f = copy_Node(other.header.f);
+            link_header();
             Size = other.Size;
             return *this;
         }
 
         ~map()
         {
-            delete_Node(root);
+            delete_Node(header.f);
             Size = 0;
         }
 
@@ -725,7 +957,7 @@ namespace sjtu
         }
         const T &at(const Key &key) const
         {
-            Node *target = const_cast<sjtu::map<Key, T, Compare> *>(this)->find_Node(key);
+            Node *target = const_cast<map *>(this)->find_Node(key);
             if (target == nullptr)
             {
                 throw index_out_of_bound();
@@ -739,7 +971,7 @@ namespace sjtu
         }
         const T &operator[](const Key &key) const
         {
-            Node *target = const_cast<sjtu::map<Key, T, Compare> *>(this)->find_Node(key);
+            Node *target = const_cast<map *>(this)->find_Node(key);
             if (target == nullptr)
             {
                 throw index_out_of_bound();
@@ -747,32 +979,40 @@ namespace sjtu
             return target->data.second;
         }
 
+        // begin、end 及其反向版本都由头结点直接给出，O(1)
         iterator begin()
         {
-            Node *p = root;
-            while (p != nullptr && p->ls != nullptr)
-            {
-                p = p->ls;
-            }
-            return iterator(p, this);
+            return iterator(Size == 0 ? &header : header.ls);
         }
         const_iterator cbegin() const
         {
-            Node *p = root;
-            while (p != nullptr && p->ls != nullptr)
-            {
-                p = p->ls;
-            }
-            return const_iterator(p, this);
+            return const_iterator(Size == 0 ? &header : header.ls);
         }
 
         iterator end()
         {
-            return iterator(nullptr, this, false);
+            return iterator(&header);
         }
         const_iterator cend() const
         {
-            return const_iterator(nullptr, this, false);
+            return const_iterator(&header);
+        }
+
+        reverse_iterator rbegin()
+        {
+            return reverse_iterator(end());
+        }
+        const_reverse_iterator crbegin() const
+        {
+            return const_reverse_iterator(cend());
+        }
+        reverse_iterator rend()
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator crend() const
+        {
+            return const_reverse_iterator(cbegin());
         }
 
         bool empty() const
@@ -787,36 +1027,139 @@ namespace sjtu
 
         void clear()
         {
-            delete_Node(root);
-            root = nullptr;
+            delete_Node(header.f);
+            header.f = nullptr;
+            link_header();
             Size = 0;
         }
 
         pair<iterator, bool> insert(const value_type &value)
         {
-            Node *father = nullptr;
-            pair<iterator, bool> tmp(insert_Node(value, root, father));
-            if (tmp.second)
+            Node *father = &header;
+            Node **link = &header.f;
+            bool leftmost = true;
+            bool rightmost = true;
+            Node *t = insert_slot(value.first, father, link, leftmost, rightmost, three_way_tag());
+            if (t != nullptr) // 插入失败
+            {
+                return pair<iterator, bool>(iterator(t), false);
+            }
+            t = new Node(value, nullptr, nullptr, father, 1);
+            *link = t;
+            thread_in(t, threaded_tag());
+            if (leftmost)
             {
-                ++Size;
+                header.ls = t;
             }
-            return tmp;
+            if (rightmost)
+            {
+                header.rs = t;
+            }
+            ++Size;
+            insert_fixup(father);
+            return pair<iterator, bool>(iterator(t), true);
         }
 
         void erase(iterator pos_)
         {
             Node *tmp = pos_.pos;
-            if (tmp == nullptr || !count(tmp->data.first) || pos_.container != this)
+            if (tmp == nullptr || tmp->h == 0)
+            {
+                throw invalid_iterator();
+            }
+            Node *top = tmp; // 回溯到头结点，确认迭代器属于本 map
+            while (top->h != 0)
+            {
+                top = top->f;
+            }
+            if (top != &header)
             {
                 throw invalid_iterator();
             }
+            if (Size == 1)
+            {
+                header.ls = header.rs = nullptr;
+            }
+            else if (tmp == header.ls)
+            {
+                header.ls = next_Node(tmp, threaded_tag());
+            }
+            else if (tmp == header.rs)
+            {
+                header.rs = prev_Node(tmp, threaded_tag());
+            }
             --Size;
-            remove(tmp->data.first, root);
+            remove_Node(tmp); // 直接从迭代器所指的节点开始删除，不再按键查找
+        }
+
+        // 写入二进制存档（格式见 serialize.hpp）：按键升序逐个写出键和值
+        template <class KeySerializer = serializer<Key>, class ValueSerializer = serializer<T>>
+        void save(std::ostream &os) const
+        {
+            write_archive_header(os, 'M', false, 0, Size);
+            for (const_iterator it = cbegin(); it != cend(); ++it)
+            {
+                KeySerializer::write(os, it->first);
+                ValueSerializer::write(os, it->second);
+            }
+            if (!os)
+            {
+                throw runtime_error();
+            }
+        }
+        // 从存档读回：键已升序，直接建出平衡树，O(n) 且不做任何旋转；
+        // 数据损坏、不足或键不严格升序时抛出 runtime_error，原内容不变
+        template <class KeySerializer = serializer<Key>, class ValueSerializer = serializer<T>>
+        void load(std::istream &is)
+        {
+            size_t n = read_archive_header(is, 'M', false, 0);
+            size_t cap = archive_reserve(is, n, (KeySerializer::bitwise ? sizeof(Key) : 1) + (ValueSerializer::bitwise ? sizeof(T) : 1));
+            Node **nodes = new Node *[cap];
+            size_t cnt = 0;
+            try
+            {
+                while (cnt < n)
+                {
+                    if (cnt == cap) // 个数未经核对时边读边倍增
+                    {
+                        cap = n - cnt < cap ? n : cap * 2;
+                        Node **bigger = new Node *[cap];
+                        for (size_t i = 0; i < cnt; ++i)
+                        {
+                            bigger[i] = nodes[i];
+                        }
+                        delete[] nodes;
+                        nodes = bigger;
+                    }
+                    Key key = KeySerializer::read(is);
+                    T value = ValueSerializer::read(is);
+                    nodes[cnt] = new Node(value_type(key, value));
+                    ++cnt;
+                    if (cnt > 1 && !compare(nodes[cnt - 2]->data.first, nodes[cnt - 1]->data.first))
+                    {
+                        throw runtime_error();
+                    }
+                }
+            }
+            catch (...)
+            {
+                for (size_t i = 0; i < cnt; ++i)
+                {
+                    delete nodes[i];
+                }
+                delete[] nodes;
+                throw;
+            }
+            clear();
+            header.f = build_Node(nodes, 0, n, &header);
+            link_header();
+            Size = n;
+            delete[] nodes;
         }
 
         size_t count(const Key &key) const
         {
-            Node *target = const_cast<sjtu::map<Key, T, Compare> *>(this)->find_Node(key);
+            Node *target = const_cast<map *>(this)->find_Node(key);
             if (target == nullptr)
             {
                 return 0;
@@ -831,16 +1174,35 @@ namespace sjtu
             {
                 return end();
             }
-            return iterator(target, this);
+            return iterator(target);
         }
         const_iterator find(const Key &key) const
         {
-            Node *target = const_cast<sjtu::map<Key, T, Compare> *>(this)->find_Node(key);
+            Node *target = const_cast<map *>(this)->find_Node(key);
             if (target == nullptr)
             {
                 return cend();
             }
-            return const_iterator(target, this);
+            return const_iterator(target);
+        }
+
+        // 第一个键不小于 key 的元素
+        iterator lower_bound(const Key &key)
+        {
+            return iterator(lower_Node(key, three_way_tag()));
+        }
+        const_iterator lower_bound(const Key &key) const
+        {
+            return const_iterator(const_cast<map *>(this)->lower_Node(key, three_way_tag()));
+        }
+        // 第一个键大于 key 的元素
+        iterator upper_bound(const Key &key)
+        {
+            return iterator(upper_Node(key, three_way_tag()));
+        }
+        const_iterator upper_bound(const Key &key) const
+        {
+            return const_iterator(const_cast<map *>(this)->upper_Node(key, three_way_tag()));
         }
     };
 
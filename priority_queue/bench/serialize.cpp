@@ -0,0 +1,48 @@
+// 存档读写：100 万个元素的堆存档后读回（两两合并建堆，O(n)），与逐个 push 重建对比
+// g++ -std=c++17 -O2 -I../src serialize.cpp -o serialize && ./serialize [n]
+#include "priority_queue.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main(int argc, char **argv)
+{
+	int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	sjtu::priority_queue<int> q;
+	for (int i = 0; i < n; ++i)
+	{
+		q.push(static_cast<int>(i * 2654435761u % n));
+	}
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	std::stringstream out;
+	q.save(out);
+	std::string blob = out.str();
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	sjtu::priority_queue<int> loaded;
+	{
+		std::stringstream in(blob);
+		loaded.load(in);
+	}
+	std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+	sjtu::priority_queue<int> pushed;
+	{
+		std::stringstream in(blob);
+		in.seekg(22); // 跳过文件头，逐个读取
+		int x;
+		while (in.read(reinterpret_cast<char *>(&x), sizeof(x)))
+		{
+			pushed.push(x);
+		}
+	}
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	printf("save %.1f ms, load %.1f ms, read + push %.1f ms (%zu %zu, top %d)\n", ms(t0, t1), ms(t1, t2), ms(t2, t3),
+		   loaded.size(), pushed.size(), loaded.top());
+	return 0;
+}
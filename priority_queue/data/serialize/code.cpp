@@ -0,0 +1,175 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "priority_queue.hpp"
+
+// 存档：读回的堆按原顺序出队，长左链的堆也能存取，从不可定位的流读入，
+// 伪造或截断的存档被拒绝；读档失败或建堆时 Compare 抛出异常都不改动原堆，也不泄漏节点
+
+// 只能顺序读取的流缓冲，模拟管道
+struct pipe_buffer : std::streambuf
+{
+	std::string s;
+	size_t p;
+	explicit pipe_buffer(const std::string &s) : s(s), p(0) {}
+	int underflow() override
+	{
+		if (p >= s.size()) {
+			return traits_type::eof();
+		}
+		setg(&s[p], &s[p], &s[p] + 1);
+		++p;
+		return static_cast<unsigned char>(s[p - 1]);
+	}
+};
+
+// throwing 为真时比较到 777 就抛出异常
+bool throwing = false;
+struct fragile_less
+{
+	bool operator()(int a, int b) const
+	{
+		if (throwing && (a == 777 || b == 777)) {
+			throw std::string("compare");
+		}
+		return a < b;
+	}
+};
+
+void TestRoundTrip()
+{
+	std::cout << "Testing round trip..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < 1000; ++i) {
+		pq.push(i * 37 % 1000);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	sjtu::priority_queue<int> back;
+	back.push(5000);
+	back.load(ss);
+	std::cout << back.size() << " ";
+	bool ok = true;
+	for (int i = 999; i >= 0; --i) {
+		ok = ok && back.top() == i;
+		back.pop();
+	}
+	std::cout << ok << " " << back.empty() << std::endl;
+
+	sjtu::priority_queue<std::string> words;
+	words.push("pear");
+	words.push("apple");
+	words.push("");
+	words.push("zebra");
+	std::stringstream ss2;
+	words.save(ss2);
+	sjtu::priority_queue<std::string> w;
+	w.load(ss2);
+	while (!w.empty()) {
+		std::cout << "[" << w.top() << "] ";
+		w.pop();
+	}
+	std::cout << std::endl;
+}
+
+void TestLongChain()
+{
+	std::cout << "Testing long left chain..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < 200000; ++i) {
+		pq.push(i);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	sjtu::priority_queue<int> back;
+	back.load(ss);
+	std::cout << back.size() << " " << back.top() << std::endl;
+	while (!pq.empty()) {
+		pq.pop();
+	}
+}
+
+void TestPipe()
+{
+	std::cout << "Testing non-seekable stream..." << std::endl;
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < 3000; ++i) {
+		pq.push(i * 7 % 3000);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	pipe_buffer pb(ss.str());
+	std::istream in(&pb);
+	sjtu::priority_queue<int> back;
+	back.load(in);
+	std::cout << back.size() << " " << back.top() << std::endl;
+}
+
+void expect_reject(const char *name, const std::string &blob, bool pipe)
+{
+	sjtu::priority_queue<int> pq;
+	pq.push(1);
+	pq.push(2);
+	std::stringstream ss(blob);
+	pipe_buffer pb(blob);
+	std::istream in(&pb);
+	try {
+		pq.load(pipe ? in : static_cast<std::istream &>(ss));
+		std::cout << name << ": accepted" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << name << ": runtime_error, size " << pq.size() << " top " << pq.top() << std::endl;
+	}
+}
+
+void TestReject()
+{
+	std::cout << "Testing corrupted archives..." << std::endl;
+	std::stringstream forged;
+	sjtu::write_archive_header(forged, 'P', false, 0, 1ULL << 40);
+	expect_reject("huge count", forged.str(), false);
+	expect_reject("huge count from pipe", forged.str(), true);
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < 100; ++i) {
+		pq.push(i);
+	}
+	std::stringstream full;
+	pq.save(full);
+	std::string blob = full.str();
+	expect_reject("truncated", blob.substr(0, blob.size() - 1), false);
+	expect_reject("wrong kind", blob.substr(0, 8) + "M" + blob.substr(9), false);
+}
+
+void TestCompareThrows()
+{
+	std::cout << "Testing Compare throwing during load..." << std::endl;
+	sjtu::priority_queue<int, fragile_less> pq;
+	for (int i = 0; i < 2000; ++i) {
+		pq.push(i);
+	}
+	std::stringstream ss;
+	pq.save(ss);
+	sjtu::priority_queue<int, fragile_less> back;
+	back.push(5);
+	throwing = true;
+	try {
+		back.load(ss);
+		std::cout << "no exception" << std::endl;
+	} catch (std::string &) {
+		std::cout << "exception, size " << back.size() << " top " << back.top() << std::endl;
+	}
+	throwing = false;
+	while (!pq.empty()) {
+		pq.pop();
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestLongChain();
+	TestPipe();
+	TestReject();
+	TestCompareThrows();
+	return 0;
+}
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <functional>
 #include "exceptions.hpp"
+#include "serialize.hpp"
 
 // 参考资料：oi wiki及csdn
 namespace sjtu
@@ -149,6 +150,109 @@ namespace sjtu
 			return !size_;
 		}
 
+		// 写入二进制存档（格式见 serialize.hpp），元素按先序逐个写出
+		template <class Serializer = serializer<T>>
+		void save(std::ostream &os) const
+		{
+			write_archive_header(os, 'P', false, 0, size_);
+			Node **stack = new Node *[size_ + 1]; // 左偏树左链可能很长，不用递归
+			size_t top_ = 0;
+			if (root)
+			{
+				stack[top_++] = root;
+			}
+			while (top_ != 0)
+			{
+				Node *a = stack[--top_];
+				Serializer::write(os, a->value);
+				if (a->rs)
+				{
+					stack[top_++] = a->rs;
+				}
+				if (a->ls)
+				{
+					stack[top_++] = a->ls;
+				}
+			}
+			delete[] stack;
+			if (!os)
+			{
+				throw runtime_error();
+			}
+		}
+		// 从存档读回：两两合并建堆，每轮堆数减半，共 O(n)；读取失败或 Compare 抛出异常时
+		// 释放已读入的节点，原内容不变
+		template <class Serializer = serializer<T>>
+		void load(std::istream &is)
+		{
+			size_t n = read_archive_header(is, 'P', false, 0);
+			size_t cap = archive_reserve(is, n, Serializer::bitwise ? sizeof(T) : 1);
+			Node **nodes = new Node *[cap];
+			size_t cnt = 0;
+			try
+			{
+				for (; cnt < n; ++cnt)
+				{
+					if (cnt == cap) // 个数未经核对时边读边倍增
+					{
+						cap = n - cnt < cap ? n : cap * 2;
+						Node **bigger = new Node *[cap];
+						for (size_t i = 0; i < cnt; ++i)
+						{
+							bigger[i] = nodes[i];
+						}
+						delete[] nodes;
+						nodes = bigger;
+					}
+					nodes[cnt] = new Node(Serializer::read(is));
+				}
+			}
+			catch (...)
+			{
+				for (size_t i = 0; i < cnt; ++i)
+				{
+					delete nodes[i];
+				}
+				delete[] nodes;
+				throw;
+			}
+			size_t i = 0, k = 0;
+			try
+			{
+				while (cnt > 1)
+				{
+					k = 0;
+					for (i = 0; i + 1 < cnt; i += 2)
+					{
+						nodes[k++] = merge_Node(nodes[i], nodes[i + 1]);
+					}
+					if (cnt % 2 == 1)
+					{
+						nodes[k++] = nodes[cnt - 1];
+					}
+					cnt = k;
+				}
+			}
+			catch (...)
+			{
+				// merge_Node 抛出时两个堆都保持原样：本轮已合并出的 nodes[0, k) 与未合并的 nodes[i, cnt) 互不相交
+				for (size_t j = 0; j < k; ++j)
+				{
+					delete_Node(nodes[j]);
+				}
+				for (size_t j = i; j < cnt; ++j)
+				{
+					delete_Node(nodes[j]);
+				}
+				delete[] nodes;
+				throw;
+			}
+			delete_Node(root);
+			root = n == 0 ? nullptr : nodes[0];
+			size_ = n;
+			delete[] nodes;
+		}
+
 		void merge(priority_queue &other)
 		{
 			root = merge_Node(root, other.root);
@@ -0,0 +1,47 @@
+// 双端队列：头尾各压入 100 万个元素、随机访问、稳定的先进先出，与 devector 和 std::deque 对比
+// g++ -std=c++17 -O2 -I../src deque.cpp -o deque && ./deque
+#include "deque.hpp"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+template <class D>
+void bench(const char *name)
+{
+	const int n = 1000000;
+	D d;
+	long long s = 0;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		d.push_back(i);
+		d.push_front(-i);
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < d.size(); i += 7)
+	{
+		s += d[i];
+	}
+	std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+	for (int i = 0; i < 10 * n; ++i) // 长度不变的队列：头出尾进
+	{
+		d.pop_front();
+		d.push_back(i);
+	}
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	printf("%-10s push both ends %.1f ms, index %.1f ms, fifo %.1f ms (%lld)\n", name, ms(t0, t1), ms(t1, t2), ms(t2, t3),
+		   s + d.back());
+}
+
+int main()
+{
+	bench<sjtu::deque<int>>("deque");
+	bench<sjtu::devector<int>>("devector");
+	bench<std::deque<int>>("std::deque");
+	return 0;
+}
@@ -0,0 +1,43 @@
+// 并行算法：1、2、4、8 个线程对 1 亿个 long long 做 for_each、reduce、inclusive_scan、copy_if，单位 ms
+// g++ -std=c++17 -O2 -I../src parallel.cpp -o parallel -pthread && ./parallel [n]
+#include "parallel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+	sjtu::vector<long long> v;
+	v.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		v.push_back(static_cast<long long>(i % 1000));
+	}
+	sjtu::vector<long long> out;
+	const size_t counts[] = {1, 2, 4, 8};
+	for (size_t threads : counts)
+	{
+		sjtu::thread_pool pool(threads);
+		sjtu::parallel::options o;
+		o.pool = &pool;
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		sjtu::parallel::for_each(v, [](long long &x) { x = (x * 3 + 1) % 1000; }, o);
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+		long long s = sjtu::parallel::reduce(v, 0LL, std::plus<long long>(), o);
+		std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+		sjtu::parallel::inclusive_scan(v, out, std::plus<long long>(), o);
+		std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+		sjtu::parallel::copy_if(v, out, [](long long x) { return x % 2 == 0; }, o);
+		std::chrono::steady_clock::time_point t4 = std::chrono::steady_clock::now();
+		printf("threads %zu: for_each %.1f, reduce %.1f, inclusive_scan %.1f, copy_if %.1f (%lld %zu)\n", threads,
+			   ms(t0, t1), ms(t1, t2), ms(t2, t3), ms(t3, t4), s, out.size());
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+// 扩容搬移：100 万个长字符串逐个 push_back，move 构造 noexcept 与可能抛异常两种元素的耗时和拷贝、移动次数
+// g++ -std=c++17 -O2 -I../src relocate.cpp -o relocate && ./relocate
+#include "vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+static size_t copies = 0;
+static size_t moves = 0;
+
+template <bool NothrowMove>
+struct text
+{
+	std::string s;
+	text(const char *p) : s(p) {}
+	text(const text &o) : s(o.s)
+	{
+		++copies;
+	}
+	text(text &&o) noexcept(NothrowMove) : s(std::move(o.s))
+	{
+		++moves;
+	}
+	text &operator=(const text &) = default;
+	text &operator=(text &&) = default;
+};
+
+template <bool NothrowMove>
+void bench(const char *name)
+{
+	const int n = 1000000;
+	copies = moves = 0;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	sjtu::vector<text<NothrowMove>> v;
+	for (int i = 0; i < n; ++i)
+	{
+		v.push_back(text<NothrowMove>("a string long enough to live on the heap"));
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	// push_back 本身移动一次（触发扩容的那次先移到临时对象，多一次），其余都是扩容搬移
+	printf("%-18s %8.1f ms, %8zu copies, %8zu moves\n", name, std::chrono::duration<double, std::milli>(t1 - t0).count(),
+		   copies, moves);
+}
+
+int main()
+{
+	bench<true>("noexcept move");
+	bench<false>("throwing move");
+	return 0;
+}
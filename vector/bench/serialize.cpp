@@ -0,0 +1,61 @@
+// 存档读写：1000 万个 long long 整块存取，与逐个 push_back 读回对比；再测 100 万个短字符串逐个存取
+// g++ -std=c++17 -O2 -I../src serialize.cpp -o serialize && ./serialize
+#include "vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main()
+{
+	const size_t n = 10000000;
+	sjtu::vector<long long> v;
+	for (size_t i = 0; i < n; ++i)
+	{
+		v.push_back(static_cast<long long>(i) * 7);
+	}
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	std::stringstream out;
+	v.save(out);
+	std::string blob = out.str();
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	sjtu::vector<long long> w;
+	{
+		std::stringstream in(blob);
+		w.load(in);
+	}
+	std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+	sjtu::vector<long long> u;
+	{
+		std::stringstream in(blob);
+		in.seekg(22); // 跳过文件头，逐个读取
+		long long x;
+		while (in.read(reinterpret_cast<char *>(&x), sizeof(x)))
+		{
+			u.push_back(x);
+		}
+	}
+	std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+	printf("vector<long long> save %.1f ms, load %.1f ms, read + push_back %.1f ms (%zu %zu)\n", ms(t0, t1), ms(t1, t2),
+		   ms(t2, t3), w.size(), u.size());
+
+	sjtu::vector<std::string> s;
+	for (size_t i = 0; i < n / 10; ++i)
+	{
+		s.push_back(std::to_string(i));
+	}
+	t0 = std::chrono::steady_clock::now();
+	std::stringstream sout;
+	s.save(sout);
+	t1 = std::chrono::steady_clock::now();
+	sjtu::vector<std::string> r;
+	r.load(sout);
+	t2 = std::chrono::steady_clock::now();
+	printf("vector<string>    save %.1f ms, load %.1f ms (%zu)\n", ms(t0, t1), ms(t1, t2), r.size());
+	return 0;
+}
@@ -0,0 +1,129 @@
+// 向量化内核：100 万个元素和能放进 L2 的 1.6 万个元素上，sum、minmax、find、count、dot 与朴素循环对比，
+// 取 20 次最好成绩（微秒），并核对结果
+// g++ -std=c++17 -O2 -I../src simd.cpp -o simd && ./simd
+#include "simd.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+volatile double sink;
+
+// 每次计时连续调用 reps 次，返回单次调用的最好成绩
+template <class F>
+double best(F f, int reps)
+{
+	double b = 1e18;
+	for (int k = 0; k < 20; ++k)
+	{
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		for (int r = 0; r < reps; ++r)
+		{
+			f();
+		}
+		b = std::min(b, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps);
+	}
+	return b;
+}
+
+template <class T>
+void bench(const char *name, size_t n)
+{
+	typedef typename sjtu::simd::accum<T>::type acc_t;
+	std::mt19937 rng(1);
+	sjtu::vector<T> v, w;
+	for (size_t i = 0; i < n; ++i)
+	{
+		v.push_back(T(rng() % 1000));
+		w.push_back(T(rng() % 7));
+	}
+	v[n - 3] = T(5000);
+	const T *p = &v[0];
+	const T *q = &w[0];
+	acc_t s = 0, d = 0;
+	size_t c = 0, f = n;
+	for (size_t i = 0; i < n; ++i)
+	{
+		s += p[i];
+		d += acc_t(p[i]) * q[i];
+		c += p[i] == T(7);
+		if (f == n && p[i] == T(5000))
+		{
+			f = i;
+		}
+	}
+	bool ok = sjtu::simd::count(v, T(7)) == c && sjtu::simd::find(v, T(5000)) == f;
+	if (std::is_integral<T>::value) // 浮点的累加顺序不同，结果可能有舍入差异
+	{
+		ok = ok && sjtu::simd::sum(v) == s && sjtu::simd::dot(v, w) == d;
+	}
+
+	int reps = n < 1000000 ? static_cast<int>(1000000 / n) : 1;
+	double t[10];
+	t[0] = best([&] {
+		acc_t a = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			a += p[i];
+		}
+		sink = a;
+	}, reps);
+	t[1] = best([&] { sink = sjtu::simd::sum(v); }, reps);
+	t[2] = best([&] {
+		T a = p[0], b = p[0];
+		for (size_t i = 0; i < n; ++i)
+		{
+			a = p[i] < a ? p[i] : a;
+			b = p[i] > b ? p[i] : b;
+		}
+		sink = a + b;
+	}, reps);
+	t[3] = best([&] {
+		sjtu::pair<T, T> m = sjtu::simd::minmax(v);
+		sink = m.first + m.second;
+	}, reps);
+	t[4] = best([&] {
+		size_t i = 0;
+		while (i < n && p[i] != T(5000))
+		{
+			++i;
+		}
+		sink = i;
+	}, reps);
+	t[5] = best([&] { sink = sjtu::simd::find(v, T(5000)); }, reps);
+	t[6] = best([&] {
+		size_t k = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			k += p[i] == T(7);
+		}
+		sink = k;
+	}, reps);
+	t[7] = best([&] { sink = sjtu::simd::count(v, T(7)); }, reps);
+	t[8] = best([&] {
+		acc_t a = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			a += acc_t(p[i]) * q[i];
+		}
+		sink = a;
+	}, reps);
+	t[9] = best([&] { sink = sjtu::simd::dot(v, w); }, reps);
+	printf("%-18s sum %6.1f/%6.1f  minmax %6.1f/%6.1f  find %6.1f/%6.1f  count %6.1f/%6.1f  dot %6.1f/%6.1f  %s\n", name, t[0],
+		   t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8], t[9], ok ? "ok" : "MISMATCH");
+}
+
+int main()
+{
+	const size_t sizes[] = {1000000, 16384};
+	for (size_t n : sizes)
+	{
+		printf("n = %zu, naive/simd, microseconds\n", n);
+		bench<int>("int", n);
+		bench<unsigned>("unsigned", n);
+		bench<long long>("long long", n);
+		bench<float>("float", n);
+		bench<double>("double", n);
+	}
+	return 0;
+}
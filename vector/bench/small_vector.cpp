@@ -0,0 +1,58 @@
+// 短向量：100 万个长度 0 到 8 的 vector 与 small_vector<int, 8> 的建立耗时和堆分配次数
+// g++ -std=c++17 -O2 -I../src small_vector.cpp -o small_vector && ./small_vector
+#include "vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static size_t allocations = 0;
+
+void *operator new(size_t n)
+{
+	++allocations;
+	void *p = std::malloc(n);
+	if (p == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+template <class V>
+void bench(const char *name)
+{
+	const int n = 1000000;
+	size_t before = allocations;
+	long long s = 0;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < n; ++i)
+	{
+		V v;
+		for (int j = 0; j < i % 9; ++j)
+		{
+			v.push_back(j);
+		}
+		s += v.size();
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+	printf("%-22s %.1f ms, %zu allocations (%lld)\n", name, std::chrono::duration<double, std::milli>(t1 - t0).count(),
+		   allocations - before, s);
+}
+
+int main()
+{
+	printf("sizeof vector<int> = %zu, sizeof small_vector<int, 8> = %zu\n", sizeof(sjtu::vector<int>),
+		   sizeof(sjtu::small_vector<int, 8>));
+	bench<sjtu::vector<int>>("vector<int>");
+	bench<sjtu::small_vector<int, 8>>("small_vector<int, 8>");
+	return 0;
+}
@@ -0,0 +1,75 @@
+// 排序：200 万个 int 在随机、有序、逆序、大量重复四种输入上，std::sort 与 sort、stable_sort、radix_sort、parallel::sort、parallel::radix_sort 对比，单位 ms
+// g++ -std=c++17 -O2 -I../src sort.cpp -o sort -pthread && ./sort [n]
+#include "sort.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static double ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+{
+	return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+int main(int argc, char **argv)
+{
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+	std::mt19937 rng(42);
+	const char *names[] = {"random", "sorted", "reversed", "dups"};
+	printf("%-9s %10s %10s %10s %10s %10s %10s\n", "input", "std::sort", "sort", "stable", "radix", "par::sort", "par::radix");
+	for (int kind = 0; kind < 4; ++kind)
+	{
+		sjtu::vector<int> v;
+		for (size_t i = 0; i < n; ++i)
+		{
+			int x = static_cast<int>(rng());
+			if (kind == 1)
+			{
+				x = static_cast<int>(i);
+			}
+			else if (kind == 2)
+			{
+				x = static_cast<int>(n - i);
+			}
+			else if (kind == 3)
+			{
+				x = static_cast<int>(rng() % 16);
+			}
+			v.push_back(x);
+		}
+		double t[6];
+		for (int k = 0; k < 6; ++k)
+		{
+			sjtu::vector<int> a(v);
+			std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+			if (k == 0)
+			{
+				std::sort(&a[0], &a[0] + n);
+			}
+			else if (k == 1)
+			{
+				sjtu::sort(a);
+			}
+			else if (k == 2)
+			{
+				sjtu::stable_sort(a);
+			}
+			else if (k == 3)
+			{
+				sjtu::radix_sort(a);
+			}
+			else if (k == 4)
+			{
+				sjtu::parallel::sort(a);
+			}
+			else
+			{
+				sjtu::parallel::radix_sort(a);
+			}
+			t[k] = ms(t0, std::chrono::steady_clock::now());
+		}
+		printf("%-9s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", names[kind], t[0], t[1], t[2], t[3], t[4], t[5]);
+	}
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include "arena.hpp"
+#include "vector.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <utility>
+
+// 单调内存池配置器：vector 在 arena 上拷贝、移动、交换时不碰全局堆；
+// 配置器不传播，赋值后各自留在自己的 arena；超大请求抛 bad_alloc
+
+static size_t allocations = 0;
+
+void *operator new(size_t n)
+{
+	++allocations;
+	void *p = std::malloc(n);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+using arena_vector = sjtu::vector<int, sjtu::default_growth_policy, 0, sjtu::arena_allocator<int>>;
+
+bool same(const arena_vector &v, int n, int mul)
+{
+	if (v.size() != static_cast<size_t>(n)) {
+		return false;
+	}
+	for (int i = 0; i < n; ++i) {
+		if (v[i] != i * mul) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestNoHeap()
+{
+	std::cout << "Testing copy/move/swap without the global heap..." << std::endl;
+	sjtu::monotonic_arena arena(4096);
+	size_t before = allocations;
+	bool ok = true;
+	{
+		sjtu::arena_allocator<int> a(arena);
+		arena_vector v(a), w(a);
+		for (int i = 0; i < 10000; ++i) {
+			v.push_back(i);
+		}
+		for (int i = 0; i < 300; ++i) {
+			w.push_back(i * 2);
+		}
+		arena_vector c(v);
+		arena_vector m(std::move(c));
+		ok = ok && same(m, 10000, 1) && c.empty();
+		w = v;
+		ok = ok && same(w, 10000, 1);
+		w.clear();
+		for (int i = 0; i < 300; ++i) {
+			w.push_back(i * 2);
+		}
+		std::swap(v, w);
+		ok = ok && same(v, 300, 2) && same(w, 10000, 1);
+		v = std::move(w);
+		ok = ok && same(v, 10000, 1);
+		v.insert(0, -1);
+		v.erase(0);
+		v.shrink_to_fit();
+		ok = ok && same(v, 10000, 1) && v.get_allocator() == a;
+	}
+	size_t heap = allocations - before;
+	std::cout << ok << " " << heap << " " << (arena.used() > 10000 * sizeof(int)) << std::endl;
+}
+
+void TestPropagation()
+{
+	std::cout << "Testing allocator propagation..." << std::endl;
+	sjtu::monotonic_arena one, two;
+	sjtu::arena_allocator<int> a(one), b(two);
+	arena_vector v(a), w(b);
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+	}
+	size_t used_two = two.used();
+	// 拷贝赋值不传播配置器：w 仍在 two 中，元素拷到 two
+	w = v;
+	std::cout << same(w, 1000, 1) << " " << (w.get_allocator() == b) << " " << (two.used() > used_two) << std::endl;
+	// 移动赋值也不传播：配置器不等，不能接管 one 的内存，逐个移动到 two
+	arena_vector x(a);
+	for (int i = 0; i < 500; ++i) {
+		x.push_back(i * 3);
+	}
+	size_t used_one = one.used();
+	w = std::move(x);
+	std::cout << same(w, 500, 3) << " " << (w.get_allocator() == b) << " " << (one.used() == used_one) << std::endl;
+	// 同一 arena 的两个配置器相等，移动赋值直接接管，不再分配
+	sjtu::arena_allocator<int> a2(one);
+	arena_vector y(a), z(a2);
+	for (int i = 0; i < 500; ++i) {
+		y.push_back(i);
+	}
+	used_one = one.used();
+	z = std::move(y);
+	std::cout << same(z, 500, 1) << " " << y.empty() << " " << (one.used() == used_one) << std::endl;
+	// 拷贝构造沿用来源的配置器
+	arena_vector c(w);
+	std::cout << (c.get_allocator() == b) << " " << same(c, 500, 3) << std::endl;
+}
+
+void TestOverflow()
+{
+	std::cout << "Testing bad_alloc..." << std::endl;
+	sjtu::monotonic_arena arena;
+	sjtu::arena_allocator<int> a(arena);
+	try {
+		a.allocate(static_cast<size_t>(-1) / 2);
+		std::cout << "no exception" << std::endl;
+	} catch (std::bad_alloc &) {
+		std::cout << "allocator: bad_alloc" << std::endl;
+	}
+	try {
+		arena.allocate(static_cast<size_t>(-1) - 16, 16);
+		std::cout << "no exception" << std::endl;
+	} catch (std::bad_alloc &) {
+		std::cout << "arena: bad_alloc" << std::endl;
+	}
+	arena_vector v(a);
+	v.push_back(7);
+	try {
+		v.reserve(static_cast<size_t>(-1) / 2);
+		std::cout << "no exception" << std::endl;
+	} catch (std::bad_alloc &) {
+		std::cout << "vector: bad_alloc" << std::endl;
+	}
+	std::cout << v.size() << " " << v[0] << " " << arena.used() << std::endl;
+}
+
+int main()
+{
+	TestNoHeap();
+	TestPropagation();
+	TestOverflow();
+	return 0;
+}
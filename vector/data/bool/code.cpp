@@ -0,0 +1,124 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+// vector<bool> 按位压缩：随机增删改后与 std::vector<bool> 比对，
+// 并检查 count、find_first/find_next、按位运算和 resize
+
+bool same(const sjtu::vector<bool> &v, const std::vector<bool> &r)
+{
+	if (v.size() != r.size()) {
+		return false;
+	}
+	size_t ones = 0;
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (v[i] != r[i]) {
+			return false;
+		}
+		ones += r[i];
+	}
+	if (v.count() != ones) {
+		return false;
+	}
+	size_t pos = v.find_first();
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (r[i]) {
+			if (pos != i) {
+				return false;
+			}
+			pos = v.find_next(pos);
+		}
+	}
+	return pos == sjtu::vector<bool>::npos;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	std::mt19937 rng(10);
+	sjtu::vector<bool> v;
+	std::vector<bool> r;
+	for (int step = 1; step <= 20000; ++step) {
+		int op = rng() % 6;
+		bool b = rng() % 2;
+		if (op < 2) {
+			v.push_back(b);
+			r.push_back(b);
+		} else if (op == 2) {
+			size_t p = rng() % (r.size() + 1);
+			v.insert(p, b);
+			r.insert(r.begin() + p, b);
+		} else if (op == 3 && !r.empty()) {
+			size_t p = rng() % r.size();
+			v.erase(v.begin() + p);
+			r.erase(r.begin() + p);
+		} else if (op == 4 && !r.empty()) {
+			v.pop_back();
+			r.pop_back();
+		} else if (op == 5 && !r.empty()) {
+			size_t p = rng() % r.size();
+			v[p] = !v[p];
+			r[p] = !r[p];
+		}
+		if (step % 2000 == 0) {
+			std::cout << v.size() << " " << v.count() << " " << same(v, r) << std::endl;
+		}
+	}
+	size_t i = 0;
+	bool iter_ok = true;
+	for (sjtu::vector<bool>::iterator it = v.begin(); it != v.end(); ++it, ++i) {
+		iter_ok = iter_ok && *it == r[i];
+	}
+	std::cout << "iterators " << iter_ok << std::endl;
+}
+
+void TestBitwise()
+{
+	std::cout << "Testing bitwise operations..." << std::endl;
+	sjtu::vector<bool> a;
+	sjtu::vector<bool> b;
+	for (int i = 0; i < 300; ++i) {
+		a.push_back(i % 3 == 0);
+		b.push_back(i % 5 == 0);
+	}
+	std::cout << a.count() << " " << b.count() << " " << (a & b).count() << " " << (a | b).count() << " "
+			  << (a ^ b).count() << " " << (~a).count() << std::endl;
+	sjtu::vector<bool> c(a);
+	c &= b;
+	std::cout << c.find_first() << " " << c.find_next(c.find_first()) << std::endl;
+	c.flip();
+	std::cout << c.count() << std::endl;
+	sjtu::vector<bool> shorter;
+	shorter.push_back(true);
+	try {
+		a &= shorter;
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "size mismatch: runtime_error" << std::endl;
+	}
+}
+
+void TestResize()
+{
+	std::cout << "Testing resize..." << std::endl;
+	sjtu::vector<bool> a;
+	a.resize(100, true);
+	std::cout << a.size() << " " << a.count() << std::endl;
+	a.resize(130);
+	a.resize(200, true);
+	std::cout << a.size() << " " << a.count() << " " << a.find_next(99) << std::endl;
+	a.resize(65);
+	std::cout << a.size() << " " << a.count() << std::endl;
+	a.clear();
+	std::cout << a.size() << " " << a.count() << " " << (a.find_first() == sjtu::vector<bool>::npos) << std::endl;
+}
+
+int main()
+{
+	TestRandom();
+	TestBitwise();
+	TestResize();
+	return 0;
+}
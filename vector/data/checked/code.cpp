@@ -0,0 +1,74 @@
+#define SJTU_CHECKED_ITERATORS
+#include "vector.hpp"
+
+#include <iostream>
+
+// 带检查的迭代器：跨容器相减、比较、插入、删除抛 invalid_iterator，
+// 越界解引用和越界移动抛 index_out_of_bound，合法用法照常工作
+
+template <class F>
+void expect(const char *name, F f)
+{
+	try {
+		f();
+		std::cout << name << ": no exception" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << name << ": invalid_iterator" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << name << ": index_out_of_bound" << std::endl;
+	}
+}
+
+void TestCrossContainer()
+{
+	std::cout << "Testing cross-container use..." << std::endl;
+	sjtu::vector<int> a, b;
+	for (int i = 0; i < 10; ++i) {
+		a.push_back(i);
+		b.push_back(i * 10);
+	}
+	const sjtu::vector<int> &ca = a;
+	const sjtu::vector<int> &cb = b;
+	expect("iterator difference", [&] { return a.begin() - b.begin(); });
+	expect("const_iterator difference", [&] { return ca.cbegin() - cb.cbegin(); });
+	expect("iterator less", [&] { return a.begin() < b.begin(); });
+	expect("const_iterator less", [&] { return ca.cend() < cb.cend(); });
+	expect("insert", [&] { a.insert(b.begin() + 2, 5); });
+	expect("range insert", [&] { a.insert(b.end(), b.begin(), b.end()); });
+	expect("erase", [&] { a.erase(b.begin()); });
+	std::cout << a.size() << " " << b.size() << " " << (a.begin() == b.begin()) << " " << (a.end() != b.end()) << std::endl;
+	// 同一容器内的合法用法
+	sjtu::vector<int>::iterator it = a.begin() + 3;
+	a.insert(it, -1);
+	a.erase(a.end() - 1);
+	std::cout << a.end() - a.begin() << " " << a[3] << " " << *(a.begin() + 4) << " " << (a.begin() < a.end()) << std::endl;
+}
+
+void TestOutOfRange()
+{
+	std::cout << "Testing out-of-range use..." << std::endl;
+	sjtu::vector<int> a;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(i);
+	}
+	const sjtu::vector<int> &ca = a;
+	expect("dereference end", [&] { return *a.end(); });
+	expect("const dereference end", [&] { return *ca.cend(); });
+	expect("advance past end", [&] { return a.begin() + 6; });
+	expect("retreat before begin", [&] { return --a.begin(); });
+	expect("const retreat before begin", [&] { return ca.cbegin() - 1; });
+	expect("increment end", [&] { sjtu::vector<int>::iterator it = a.end(); ++it; });
+	expect("subscript", [&] { return a.begin()[5]; });
+	expect("singular", [&] { return *sjtu::vector<int>::iterator(); });
+	// 恰好到 end 是合法的
+	expect("advance to end", [&] { return a.begin() + 5; });
+	expect("last element", [&] { return a.end()[-1]; });
+	std::cout << a.end()[-1] << " " << *(ca.cend() - 5) << std::endl;
+}
+
+int main()
+{
+	TestCrossContainer();
+	TestOutOfRange();
+	return 0;
+}
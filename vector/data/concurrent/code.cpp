@@ -0,0 +1,85 @@
+#include "concurrent_vector.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 并发追加向量：单线程下的下标和地址稳定性；多个线程同时追加时每个元素恰好出现一次，
+// 读线程看到的 size() 单调不减且下标小于 size() 的元素都已构造完成
+
+void TestSingleThread()
+{
+	std::cout << "Testing single thread..." << std::endl;
+	sjtu::concurrent_vector<std::string> v;
+	bool ok = true;
+	for (int i = 0; i < 1000; ++i) {
+		ok = ok && v.push_back(std::to_string(i)) == static_cast<size_t>(i);
+	}
+	std::cout << ok << " " << v.size() << " " << v[999] << std::endl;
+	std::string *p = &v[5];
+	for (int i = 0; i < 5000; ++i) {
+		v.emplace_back(3, 'x');
+	}
+	std::cout << (p == &v[5]) << " " << v[5] << " " << v[5999] << " " << v.size() << std::endl;
+	try {
+		v.at(6000);
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at(size): index_out_of_bound" << std::endl;
+	}
+	v.clear();
+	std::cout << v.empty() << " ";
+	v.push_back("again");
+	std::cout << v.size() << " " << v[0] << std::endl;
+}
+
+void TestThreads(size_t threads)
+{
+	std::cout << "Testing " << threads << " writer threads..." << std::endl;
+	const size_t total = 200000;
+	sjtu::concurrent_vector<long long> v;
+	std::atomic<bool> stop(false);
+	std::atomic<bool> reader_ok(true);
+	std::thread reader([&] {
+		size_t last = 0;
+		while (!stop.load()) {
+			size_t n = v.size();
+			if (n < last || (n > 0 && (v[n - 1] < 0 || v[n - 1] >= static_cast<long long>(total)))) {
+				reader_ok.store(false);
+			}
+			last = n;
+		}
+	});
+	std::vector<std::thread> writers;
+	for (size_t t = 0; t < threads; ++t) {
+		writers.push_back(std::thread([&v, t, threads] {
+			for (size_t i = t; i < total; i += threads) {
+				v.push_back(static_cast<long long>(i));
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads; ++t) {
+		writers[t].join();
+	}
+	stop.store(true);
+	reader.join();
+	std::vector<char> seen(total, 0);
+	bool unique = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		long long x = v[i];
+		unique = unique && !seen[x];
+		seen[x] = 1;
+	}
+	std::cout << v.size() << " " << unique << " " << reader_ok.load() << std::endl;
+}
+
+int main()
+{
+	TestSingleThread();
+	TestThreads(1);
+	TestThreads(4);
+	TestThreads(16);
+	return 0;
+}
@@ -0,0 +1,198 @@
+#include "cow_vector.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 写时复制：拷贝只加引用计数，第一次修改时才深拷贝；交出可写引用或迭代器后该对象不再共享，
+// 之后的拷贝都是深拷贝，经引用写入不会影响副本；共享时追加元素只分配一次；
+// 多个线程各自拷贝、读取同一缓冲区的副本
+
+static std::atomic<size_t> allocations(0);
+
+void *operator new(size_t n)
+{
+	++allocations;
+	void *p = std::malloc(n);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+typedef sjtu::cow_vector<std::string> cow;
+
+void print(const cow &v)
+{
+	for (cow::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << "(" << v.size() << ")" << std::endl;
+}
+
+void TestSharing()
+{
+	std::cout << "Testing sharing..." << std::endl;
+	cow a;
+	std::cout << a.use_count() << " " << a.empty() << std::endl;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	cow b(a);
+	cow c;
+	c = b;
+	std::cout << a.use_count() << " " << (a.cbegin() == c.cbegin()) << std::endl;
+	b.push_back("b");
+	std::cout << a.use_count() << " " << b.use_count() << std::endl;
+	print(a);
+	print(b);
+	c.pop_back();
+	c.insert(0, "c");
+	print(a);
+	print(c);
+	std::cout << a.use_count() << " " << c.use_count() << std::endl;
+	cow d(a);
+	d.clear();
+	std::cout << a.use_count() << " " << d.use_count() << " " << d.size() << std::endl;
+	cow e(std::move(a));
+	std::cout << a.size() << " " << e.use_count() << std::endl;
+}
+
+void TestUnshareable()
+{
+	std::cout << "Testing unshareable after handing out references..." << std::endl;
+	cow a;
+	for (int i = 0; i < 3; ++i) {
+		a.push_back(std::to_string(i));
+	}
+	std::string &ref = a[1];
+	cow b(a);
+	ref = "changed";
+	std::cout << a.use_count() << " " << b.use_count() << " " << a[1] << " " << b[1] << std::endl;
+	cow::iterator it = a.begin();
+	cow c;
+	c = a;
+	*it = "first";
+	print(a);
+	print(c);
+	a.clear();
+	a.push_back("x");
+	cow d(a);
+	std::cout << a.use_count() << " " << d.use_count() << std::endl;
+}
+
+void TestReserve()
+{
+	std::cout << "Testing reserve on a shared buffer..." << std::endl;
+	sjtu::cow_vector<int> a;
+	for (int i = 0; i < 10; ++i) {
+		a.push_back(i);
+	}
+	sjtu::cow_vector<int> b(a);
+	b.reserve(1000);
+	std::cout << a.use_count() << " " << b.use_count() << " " << (b.capacity() >= 1000) << " " << b.size() << " "
+			  << b.cbegin()[9] << std::endl;
+	const sjtu::cow_vector<int> &cb = b;
+	std::cout << cb.at(3) << " " << cb.front() << " " << cb.back() << std::endl;
+	try {
+		cb.at(10);
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "at(size): index_out_of_bound" << std::endl;
+	}
+}
+
+// 共享缓冲区上追加：新的 rep 一次，按追加后所需容量深拷贝一次，不再为放下新元素而扩容
+void TestAppendShared()
+{
+	std::cout << "Testing appends on a shared buffer..." << std::endl;
+	sjtu::cow_vector<int> a;
+	for (int i = 0; i < 8; ++i) {
+		a.push_back(i);
+	}
+	size_t cap = a.capacity();
+	sjtu::cow_vector<int> b(a), c(a), d(a);
+	size_t before = allocations;
+	b.push_back(8);
+	size_t pushed = allocations - before;
+	before = allocations;
+	c.emplace_back(8);
+	size_t emplaced = allocations - before;
+	before = allocations;
+	d.insert(0, -1);
+	size_t inserted = allocations - before;
+	std::cout << cap << " " << pushed << " " << emplaced << " " << inserted << " " << a.use_count() << " " << a.size()
+			  << " " << b.back() << " " << c.back() << " " << d.front() << " " << d.size() << std::endl;
+	// 独占时照常按策略倍增，不会每次只多留一个
+	sjtu::cow_vector<int> e;
+	e.push_back(0);
+	before = allocations;
+	for (int i = 1; i < 1024; ++i) {
+		e.push_back(i);
+	}
+	std::cout << allocations - before << " " << e.capacity() << std::endl;
+	// 共享但容量有余：深拷贝沿用原容量
+	sjtu::cow_vector<int> f(e);
+	f.pop_back();
+	sjtu::cow_vector<int> g(f);
+	before = allocations;
+	g.push_back(7);
+	std::cout << allocations - before << " " << g.capacity() << " " << f.size() << " " << g.back() << std::endl;
+}
+
+void TestThreads()
+{
+	std::cout << "Testing copies across threads..." << std::endl;
+	sjtu::cow_vector<int> shared;
+	for (int i = 0; i < 1000; ++i) {
+		shared.push_back(i);
+	}
+	std::vector<long long> sums(8, 0);
+	std::vector<std::thread> ts;
+	for (int t = 0; t < 8; ++t) {
+		ts.push_back(std::thread([&shared, &sums, t] {
+			for (int round = 0; round < 200; ++round) {
+				sjtu::cow_vector<int> mine(shared);
+				const sjtu::cow_vector<int> &view = mine;
+				long long s = 0;
+				for (size_t i = 0; i < view.size(); ++i) {
+					s += view[i];
+				}
+				if (round % 2 == 0) {
+					mine.push_back(t);
+					s += mine.cbegin()[1000];
+				}
+				sums[t] += s;
+			}
+		}));
+	}
+	for (int t = 0; t < 8; ++t) {
+		ts[t].join();
+	}
+	for (int t = 0; t < 8; ++t) {
+		std::cout << sums[t] << " ";
+	}
+	std::cout << std::endl << shared.use_count() << std::endl;
+}
+
+int main()
+{
+	TestSharing();
+	TestUnshareable();
+	TestReserve();
+	TestAppendShared();
+	TestThreads();
+	return 0;
+}
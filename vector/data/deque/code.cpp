@@ -0,0 +1,289 @@
+#include "deque.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// 分块双端队列：跨块的头尾增删、头尾增删后元素地址不变、空闲块缓存的复用、
+// 随机访问迭代器的算术，以及配置器相等与不等时的拷贝、移动赋值
+
+// 每个配置器编号上未归还的字节数和分配 int 块的次数，第一维是传播属性
+struct alloc_stats
+{
+	long bytes;
+	int blocks;
+};
+alloc_stats stats[2][4];
+
+// 带编号的配置器，编号不同即不相等
+template <class T, bool Prop>
+struct tagged_allocator
+{
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::integral_constant<bool, Prop>;
+	using propagate_on_container_move_assignment = std::integral_constant<bool, Prop>;
+	using propagate_on_container_swap = std::integral_constant<bool, Prop>;
+	using is_always_equal = std::false_type;
+	template <class U>
+	struct rebind
+	{
+		using other = tagged_allocator<U, Prop>;
+	};
+
+	int id;
+	tagged_allocator(int id = 0) : id(id) {}
+	template <class U>
+	tagged_allocator(const tagged_allocator<U, Prop> &other) : id(other.id) {}
+
+	T *allocate(size_t n)
+	{
+		stats[Prop][id].bytes += static_cast<long>(n * sizeof(T));
+		if (std::is_same<T, int>::value) {
+			++stats[Prop][id].blocks;
+		}
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+	void deallocate(T *p, size_t n)
+	{
+		stats[Prop][id].bytes -= static_cast<long>(n * sizeof(T));
+		::operator delete(p);
+	}
+	bool operator==(const tagged_allocator &other) const
+	{
+		return id == other.id;
+	}
+	bool operator!=(const tagged_allocator &other) const
+	{
+		return id != other.id;
+	}
+};
+
+template <class V>
+bool same(const V &v, const std::deque<int> &r)
+{
+	if (v.size() != r.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (v[i] != r[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestEnds()
+{
+	std::cout << "Testing push/pop at both ends..." << std::endl;
+	std::mt19937 rng(9);
+	sjtu::deque<int> d;
+	std::deque<int> r;
+	const size_t bs = sjtu::deque<int>::block_size;
+	for (int round = 0; round < 6; ++round) {
+		// 每轮先偏向增长再偏向收缩，反复跨过块边界
+		for (size_t i = 0; i < 3 * bs + 17; ++i) {
+			int x = static_cast<int>(rng() % 100000);
+			int op = static_cast<int>(rng() % 10);
+			bool grow = (round % 2 == 0) ? op < 7 : op < 3;
+			if (grow) {
+				if (rng() % 2) {
+					d.push_back(x);
+					r.push_back(x);
+				} else {
+					d.push_front(x);
+					r.push_front(x);
+				}
+			} else if (!r.empty()) {
+				if (rng() % 2) {
+					d.pop_back();
+					r.pop_back();
+				} else {
+					d.pop_front();
+					r.pop_front();
+				}
+			}
+		}
+		std::cout << d.size() << " " << same(d, r) << std::endl;
+	}
+	while (!r.empty()) {
+		d.pop_front();
+		r.pop_front();
+	}
+	try {
+		d.pop_back();
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty: container_is_empty" << std::endl;
+	}
+}
+
+void TestStability()
+{
+	std::cout << "Testing address stability..." << std::endl;
+	sjtu::deque<int> d;
+	const int n = 5000;
+	for (int i = 0; i < n; ++i) {
+		d.push_back(i);
+	}
+	std::vector<int *> addr;
+	for (int i = 0; i < n; ++i) {
+		addr.push_back(&d[i]);
+	}
+	for (int i = 0; i < 3 * n; ++i) {
+		d.push_front(-i);
+		d.push_back(n + i);
+	}
+	bool ok = true;
+	for (int i = 0; i < n; ++i) {
+		ok = ok && &d[3 * n + i] == addr[i] && *addr[i] == i;
+	}
+	for (int i = 0; i < 3 * n; ++i) {
+		d.pop_front();
+		d.pop_back();
+	}
+	for (int i = 0; i < n; ++i) {
+		ok = ok && &d[i] == addr[i];
+	}
+	std::cout << ok << " " << d.size() << " " << d.front() << " " << d.back() << std::endl;
+}
+
+void TestCache()
+{
+	std::cout << "Testing block cache..." << std::endl;
+	using alloc = tagged_allocator<int, false>;
+	const size_t bs = sjtu::deque<int, alloc>::block_size;
+	{
+		sjtu::deque<int, alloc> d{alloc(1)};
+		for (size_t i = 0; i < 3 * bs; ++i) {
+			d.push_back(static_cast<int>(i));
+		}
+		// 稳定的队列进出：第一次跨块要新申请一块，之后尾部要新块时总有首块刚空出、进了缓存
+		long sum = 0;
+		for (size_t i = 0; i < bs; ++i) {
+			d.push_back(static_cast<int>(i));
+			sum += d.front();
+			d.pop_front();
+		}
+		int warm = stats[0][1].blocks;
+		for (size_t i = 0; i < 50 * bs; ++i) {
+			d.push_back(static_cast<int>(i));
+			sum += d.front();
+			d.pop_front();
+		}
+		std::cout << warm << " " << stats[0][1].blocks - warm << " " << d.size() << " " << sum << std::endl;
+		// 首端成批进出同样复用，第一轮补足缓存后不再申请
+		int before = 0;
+		for (int k = 0; k < 20; ++k) {
+			if (k == 1) {
+				before = stats[0][1].blocks;
+			}
+			for (size_t i = 0; i < 2 * bs; ++i) {
+				d.push_front(1);
+			}
+			for (size_t i = 0; i < 2 * bs; ++i) {
+				d.pop_front();
+			}
+		}
+		std::cout << stats[0][1].blocks - before << std::endl;
+		d.shrink_to_fit();
+	}
+	std::cout << stats[0][1].bytes << std::endl;
+}
+
+void TestIterators()
+{
+	std::cout << "Testing iterator arithmetic..." << std::endl;
+	std::mt19937 rng(90);
+	sjtu::deque<int> d;
+	std::deque<int> r;
+	for (int i = 0; i < 6000; ++i) {
+		if (i % 3 == 0) {
+			d.push_front(i);
+			r.push_front(i);
+		} else {
+			d.push_back(i);
+			r.push_back(i);
+		}
+	}
+	const sjtu::deque<int> &cd = d;
+	long n = static_cast<long>(r.size());
+	bool ok = d.end() - d.begin() == n && cd.cend() - cd.cbegin() == n;
+	for (int t = 0; t < 2000; ++t) {
+		long i = static_cast<long>(rng() % r.size());
+		long j = static_cast<long>(rng() % r.size());
+		sjtu::deque<int>::iterator a = d.begin() + i;
+		sjtu::deque<int>::iterator b = j + d.begin();
+		sjtu::deque<int>::const_iterator c = cd.cend() - (n - i);
+		ok = ok && *a == r[i] && *b == r[j] && *c == r[i];
+		ok = ok && b - a == j - i && a[j - i] == r[j] && c[j - i] == r[j];
+		ok = ok && (a < b) == (i < j) && (a <= b) == (i <= j) && (a > b) == (i > j) && (a >= b) == (i >= j);
+		ok = ok && (a == b) == (i == j) && (a != b) == (i != j);
+		a += j - i;
+		c -= i - j;
+		ok = ok && a == b && *c == r[j];
+	}
+	// 逐个前进、后退跨过所有块边界
+	long k = 0;
+	for (sjtu::deque<int>::iterator it = d.begin(); it != d.end(); ++it, ++k) {
+		ok = ok && *it == r[k];
+	}
+	for (sjtu::deque<int>::const_iterator it = cd.cend(); it != cd.cbegin();) {
+		--it;
+		--k;
+		ok = ok && *it == r[k];
+	}
+	sjtu::deque<int>::iterator p = d.begin();
+	sjtu::deque<int>::iterator q = p++;
+	sjtu::deque<int>::iterator s = p--;
+	ok = ok && q == d.begin() && s - p == 1 && p == d.begin();
+	std::sort(d.begin(), d.end());
+	std::sort(r.begin(), r.end());
+	std::cout << ok << " " << k << " " << same(d, r) << std::endl;
+}
+
+template <bool Prop>
+void TestAssign()
+{
+	std::cout << "Testing assignment, propagate = " << Prop << "..." << std::endl;
+	using alloc = tagged_allocator<int, Prop>;
+	using D = sjtu::deque<int, alloc>;
+	std::deque<int> r;
+	for (int i = 0; i < 3000; ++i) {
+		r.push_back(i * 7 % 1000);
+	}
+	{
+		D a{alloc(1)}, b{alloc(1)}, c{alloc(2)};
+		for (size_t i = 0; i < r.size(); ++i) {
+			a.push_back(r[i]);
+		}
+		b = a; // 配置器相等
+		c = a; // 配置器不等
+		std::cout << same(b, r) << same(c, r) << " " << stats[Prop][1].bytes / 1000 << " " << stats[Prop][2].bytes / 1000 << std::endl;
+		D e{alloc(1)}, f{alloc(3)};
+		int blocks = stats[Prop][1].blocks + stats[Prop][3].blocks;
+		e = std::move(b); // 配置器相等：接管块，不逐个移动
+		std::cout << same(e, r) << b.empty() << " " << stats[Prop][1].blocks + stats[Prop][3].blocks - blocks << std::endl;
+		blocks = stats[Prop][1].blocks + stats[Prop][3].blocks;
+		f = std::move(c); // 配置器不等：传播时接管，否则在 f 自己的配置器里逐个移动
+		std::cout << same(f, r) << c.empty() << " " << stats[Prop][1].blocks + stats[Prop][3].blocks - blocks << std::endl;
+		f.push_back(-1);
+		f.pop_front();
+		r.push_back(-1);
+		r.pop_front();
+		std::cout << same(f, r) << " " << f.front() << " " << f.back() << std::endl;
+	}
+	std::cout << stats[Prop][1].bytes << " " << stats[Prop][2].bytes << " " << stats[Prop][3].bytes << std::endl;
+}
+
+int main()
+{
+	TestEnds();
+	TestStability();
+	TestCache();
+	TestIterators();
+	TestAssign<false>();
+	TestAssign<true>();
+	return 0;
+}
@@ -0,0 +1,246 @@
+#include "devector.hpp"
+
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+
+// 双端向量：头尾增删、中间增删向较近一端搬移、空位不足时原地居中、
+// 含自指针（不可平凡搬移）的元素，以及不传播配置器时的拷贝和移动赋值
+
+// 记住自己地址的元素：被按字节搬移后 self 不再指向自己；live 统计存活对象数
+struct pinned
+{
+	static int live;
+	int v;
+	pinned *self;
+	pinned(int v = 0) : v(v), self(this)
+	{
+		++live;
+	}
+	pinned(const pinned &other) : v(other.v), self(this)
+	{
+		++live;
+	}
+	pinned(pinned &&other) noexcept : v(other.v), self(this)
+	{
+		other.v = -1;
+		++live;
+	}
+	pinned &operator=(const pinned &other)
+	{
+		v = other.v;
+		return *this;
+	}
+	pinned &operator=(pinned &&other) noexcept
+	{
+		v = other.v;
+		other.v = -1;
+		return *this;
+	}
+	~pinned()
+	{
+		--live;
+	}
+	bool ok() const
+	{
+		return self == this;
+	}
+};
+int pinned::live = 0;
+
+// 带编号的配置器，编号不同即不相等；两个传播属性由模板参数决定
+template <class T, bool CopyProp, bool MoveProp>
+struct tagged_allocator
+{
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::integral_constant<bool, CopyProp>;
+	using propagate_on_container_move_assignment = std::integral_constant<bool, MoveProp>;
+	using is_always_equal = std::false_type;
+	template <class U>
+	struct rebind
+	{
+		using other = tagged_allocator<U, CopyProp, MoveProp>;
+	};
+
+	int id;
+	tagged_allocator(int id = 0) : id(id) {}
+	template <class U>
+	tagged_allocator(const tagged_allocator<U, CopyProp, MoveProp> &other) : id(other.id) {}
+
+	T *allocate(size_t n)
+	{
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+	void deallocate(T *p, size_t)
+	{
+		::operator delete(p);
+	}
+	bool operator==(const tagged_allocator &other) const
+	{
+		return id == other.id;
+	}
+	bool operator!=(const tagged_allocator &other) const
+	{
+		return id != other.id;
+	}
+};
+
+template <class V>
+bool same(const V &v, const std::deque<int> &r)
+{
+	if (v.size() != r.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (v[i] != r[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestBothEnds()
+{
+	std::cout << "Testing both ends..." << std::endl;
+	std::mt19937 rng(8);
+	sjtu::devector<int> v;
+	std::deque<int> r;
+	for (int step = 1; step <= 20000; ++step) {
+		int op = rng() % 8;
+		int x = rng() % 1000;
+		if (op < 2) {
+			v.push_back(x);
+			r.push_back(x);
+		} else if (op < 4) {
+			v.push_front(x);
+			r.push_front(x);
+		} else if (op == 4 && !r.empty()) {
+			v.pop_back();
+			r.pop_back();
+		} else if (op == 5 && !r.empty()) {
+			v.pop_front();
+			r.pop_front();
+		} else if (op == 6) {
+			size_t p = rng() % (r.size() + 1);
+			v.insert(p, x);
+			r.insert(r.begin() + p, x);
+		} else if (op == 7 && !r.empty()) {
+			size_t p = rng() % r.size();
+			v.erase(p);
+			r.erase(r.begin() + p);
+		}
+		if (step % 4000 == 0) {
+			std::cout << v.size() << " " << same(v, r) << " " << (v.front_free() + v.size() + v.back_free() == v.capacity())
+					  << std::endl;
+		}
+	}
+	try {
+		sjtu::devector<int> e;
+		e.pop_front();
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "pop_front on empty: container_is_empty" << std::endl;
+	}
+}
+
+void TestCloserEnd()
+{
+	std::cout << "Testing shifts toward the closer end..." << std::endl;
+	sjtu::devector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	v.push_front(-1);
+	v.pop_front();
+	size_t front = v.front_free(), back = v.back_free();
+	v.insert(2, 100); // 靠近头部：前半段左移
+	std::cout << (v.front_free() == front - 1) << " " << (v.back_free() == back) << std::endl;
+	front = v.front_free();
+	v.insert(9, 200); // 靠近尾部：后半段右移
+	std::cout << (v.front_free() == front) << " " << (v.back_free() == back - 1) << std::endl;
+	v.erase(1); // 前半段右移补位
+	std::cout << (v.front_free() == front + 1) << " " << (v.back_free() == back - 1) << std::endl;
+	v.erase(8); // 后半段左移补位
+	std::cout << (v.front_free() == front + 1) << " " << (v.back_free() == back) << std::endl;
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestRecentre()
+{
+	std::cout << "Testing re-centring..." << std::endl;
+	sjtu::devector<pinned> v;
+	for (int i = 0; i < 64; ++i) {
+		v.push_back(pinned(i));
+	}
+	for (int i = 0; i < 40; ++i) {
+		v.pop_front();
+	}
+	size_t cap = v.capacity();
+	while (v.back_free() != 0) {
+		v.push_back(pinned(static_cast<int>(v.size())));
+	}
+	v.push_back(pinned(1000)); // 尾部满、头部空闲过半：原地居中，不扩容
+	v.insert(3, pinned(2000));
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		ok = ok && v[i].ok() && v[i].v >= 0;
+	}
+	std::cout << (v.capacity() == cap) << " " << (v.front_free() > 0) << " " << ok << " " << v.front().v << " "
+			  << v[3].v << " " << v.back().v << " " << (pinned::live == static_cast<int>(v.size())) << std::endl;
+	for (int i = 0; i < 200; ++i) {
+		v.push_front(pinned(-i - 1 + 1000000));
+	}
+	for (size_t i = 0; i < v.size(); ++i) {
+		ok = ok && v[i].ok();
+	}
+	std::cout << v.size() << " " << ok << " " << (pinned::live == static_cast<int>(v.size())) << std::endl;
+	v.clear();
+	std::cout << pinned::live << std::endl;
+}
+
+template <bool CopyProp, bool MoveProp>
+void TestAllocator(const char *name)
+{
+	typedef tagged_allocator<pinned, CopyProp, MoveProp> alloc_type;
+	typedef sjtu::devector<pinned, sjtu::default_growth_policy, alloc_type> dv;
+	std::cout << "Testing allocator (" << name << ")..." << std::endl;
+	dv a(alloc_type(1));
+	for (int i = 0; i < 20; ++i) {
+		a.push_front(pinned(i));
+	}
+	dv b(alloc_type(2));
+	b.push_back(pinned(7));
+	b = a;
+	bool ok = b.size() == 20;
+	for (size_t i = 0; ok && i < b.size(); ++i) {
+		ok = b[i].ok() && b[i].v == a[i].v;
+	}
+	std::cout << "copy " << ok << " " << (b.front().v == 19) << " allocator " << b.get_allocator().id << std::endl;
+
+	dv c(alloc_type(3));
+	c = std::move(a);
+	ok = c.size() == 20;
+	for (size_t i = 0; ok && i < c.size(); ++i) {
+		ok = c[i].ok() && c[i].v == 19 - static_cast<int>(i);
+	}
+	std::cout << "move " << ok << " " << a.size() << " allocator " << c.get_allocator().id << std::endl;
+	dv d(c);
+	d.push_back(pinned(5));
+	std::cout << "copy construct " << d.size() << " " << d.back().v << " allocator " << d.get_allocator().id << std::endl;
+}
+
+int main()
+{
+	TestBothEnds();
+	TestCloserEnd();
+	TestRecentre();
+	TestAllocator<false, false>("no propagation");
+	TestAllocator<false, true>("propagate on move only");
+	TestAllocator<true, true>("propagate on copy and move");
+	std::cout << "live " << pinned::live << std::endl;
+	return 0;
+}
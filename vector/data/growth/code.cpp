@@ -0,0 +1,142 @@
+#include "vector.hpp"
+
+#include <iostream>
+
+// 容量策略：扩容、缩容的容量序列；在扩容和缩容边界上交替 push/pop 或 insert/erase
+// 只换一次缓冲区，不会来回抖动；no_shrink_policy 从不缩容，reserve 和 shrink_to_fit 按需调整
+
+// 每次操作后检查容量是否变化，统计换缓冲区的次数
+template <class V>
+struct watcher
+{
+	V &v;
+	size_t last;
+	int changes;
+	explicit watcher(V &v) : v(v), last(v.capacity()), changes(0) {}
+	void step()
+	{
+		if (v.capacity() != last) {
+			last = v.capacity();
+			++changes;
+		}
+	}
+};
+
+template <class V>
+void print_growth(const char *name)
+{
+	V v;
+	watcher<V> w(v);
+	std::cout << name << ":";
+	for (int i = 0; i < 200; ++i) {
+		v.push_back(i);
+		int before = w.changes;
+		w.step();
+		if (w.changes != before) {
+			std::cout << " " << v.capacity();
+		}
+	}
+	std::cout << std::endl;
+	std::cout << name << " shrink:";
+	while (!v.empty()) {
+		v.pop_back();
+		int before = w.changes;
+		w.step();
+		if (w.changes != before) {
+			std::cout << " " << v.capacity() << "@" << v.size();
+		}
+	}
+	std::cout << std::endl;
+}
+
+void TestSequences()
+{
+	std::cout << "Testing capacity sequences..." << std::endl;
+	print_growth<sjtu::vector<int>>("default");
+	print_growth<sjtu::vector<int, sjtu::growth_policy<3, 2, 3>>>("3/2, 1/3");
+	print_growth<sjtu::vector<int, sjtu::no_shrink_policy>>("no shrink");
+}
+
+void TestGrowBoundary()
+{
+	std::cout << "Testing the grow boundary..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 64; ++i) {
+		v.push_back(i);
+	}
+	watcher<sjtu::vector<int>> w(v);
+	// 恰好满时 push 扩到 128，之后 pop 到 63 远高于 128 / 4，不缩容
+	for (int k = 0; k < 1000; ++k) {
+		v.push_back(k);
+		w.step();
+		v.pop_back();
+		w.step();
+	}
+	std::cout << w.changes << " " << v.capacity() << " " << v.size() << std::endl;
+}
+
+void TestShrinkBoundary()
+{
+	std::cout << "Testing the shrink boundary..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 128; ++i) {
+		v.push_back(i);
+	}
+	watcher<sjtu::vector<int>> w(v);
+	while (v.size() > 33) {
+		v.pop_back();
+		w.step();
+	}
+	std::cout << w.changes << " " << v.capacity() << std::endl;
+	// 降到 32 = 128 / 4 时缩到 64，之后在 32、33 之间来回：64 / 4 = 16，离两个边界都远
+	for (int k = 0; k < 1000; ++k) {
+		v.pop_back();
+		w.step();
+		v.push_back(k);
+		w.step();
+	}
+	std::cout << w.changes << " " << v.capacity() << " " << v.size() << std::endl;
+	// erase / insert 走同一套判断
+	for (int k = 0; k < 1000; ++k) {
+		v.erase(0);
+		w.step();
+		v.insert(0, k);
+		w.step();
+	}
+	std::cout << w.changes << " " << v.capacity() << " " << v.size() << std::endl;
+}
+
+void TestReserve()
+{
+	std::cout << "Testing reserve and shrink_to_fit..." << std::endl;
+	sjtu::vector<int, sjtu::no_shrink_policy> v;
+	v.reserve(1000);
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.capacity() << std::endl;
+	while (v.size() > 1) {
+		v.pop_back();
+	}
+	std::cout << v.capacity() << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << std::endl;
+	v.shrink_to_fit();
+	std::cout << v.capacity() << " " << v[0] << std::endl;
+	// 默认策略下 reserve 出的大容量在 pop 时会按策略缩回
+	sjtu::vector<int> u;
+	u.reserve(1000);
+	u.push_back(1);
+	u.push_back(2);
+	u.pop_back();
+	std::cout << u.capacity() << std::endl;
+}
+
+int main()
+{
+	TestSequences();
+	TestGrowBoundary();
+	TestShrinkBoundary();
+	TestReserve();
+	return 0;
+}
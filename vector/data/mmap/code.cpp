@@ -0,0 +1,132 @@
+#include "mmap_vector.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+// 文件映射向量：随机增删后与 std::vector 比对，关闭再打开后内容和个数不变，
+// 删除元素时容量和文件大小不变，只有 shrink_to_fit 才截短文件，元素大小不符的文件拒绝打开
+
+const char *path = "mmap_vector.test.bin";
+
+struct point
+{
+	int x;
+	int y;
+};
+
+bool same(const sjtu::mmap_vector<int> &v, const std::vector<int> &r)
+{
+	if (v.size() != r.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (v[i] != r[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRandom(std::vector<int> &r)
+{
+	std::cout << "Testing random operations..." << std::endl;
+	std::mt19937 rng(13);
+	sjtu::mmap_vector<int> v(path);
+	std::cout << v.is_open() << " " << v.size() << std::endl;
+	for (int step = 1; step <= 20000; ++step) {
+		int op = rng() % 4;
+		int x = rng() % 100000;
+		if (op < 2) {
+			v.push_back(x);
+			r.push_back(x);
+		} else if (op == 2) {
+			size_t p = rng() % (r.size() + 1);
+			v.insert(p, x);
+			r.insert(r.begin() + p, x);
+		} else if (!r.empty()) {
+			size_t p = rng() % r.size();
+			v.erase(p);
+			r.erase(r.begin() + p);
+		}
+		if (step % 4000 == 0) {
+			std::cout << v.size() << " " << same(v, r) << std::endl;
+		}
+	}
+	v.sync();
+}
+
+void TestReopen(std::vector<int> &r)
+{
+	std::cout << "Testing reopen..." << std::endl;
+	sjtu::mmap_vector<int> v(path);
+	std::cout << v.size() << " " << same(v, r) << " " << (v.capacity() >= v.size()) << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(-i);
+		r.push_back(-i);
+	}
+	v.close();
+	std::cout << v.is_open() << " " << v.size() << std::endl;
+	v.open(path);
+	std::cout << v.size() << " " << same(v, r) << " " << v.back() << std::endl;
+}
+
+size_t file_size()
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	return static_cast<size_t>(file.tellg());
+}
+
+void TestShrink(std::vector<int> &r)
+{
+	std::cout << "Testing shrink..." << std::endl;
+	sjtu::mmap_vector<int> v(path);
+	size_t before = v.capacity();
+	while (v.size() > 10) {
+		v.erase(v.begin());
+		r.erase(r.begin());
+		if (v.size() > 10) {
+			v.pop_back();
+			r.pop_back();
+		}
+	}
+	// 删除不截短文件，容量和文件大小都不变
+	std::cout << v.size() << " " << same(v, r) << " " << (v.capacity() == before)
+			  << " " << (file_size() == 64 + before * sizeof(int)) << std::endl;
+	v.shrink_to_fit();
+	size_t cap = v.capacity();
+	v.close();
+	std::cout << cap << " " << (file_size() == 64 + cap * sizeof(int)) << std::endl;
+	try {
+		v.pop_back();
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "closed: container_is_empty" << std::endl;
+	}
+}
+
+void TestMismatch()
+{
+	std::cout << "Testing element size mismatch..." << std::endl;
+	try {
+		sjtu::mmap_vector<point> p(path);
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "runtime_error" << std::endl;
+	}
+}
+
+int main()
+{
+	::unlink(path);
+	std::vector<int> r;
+	TestRandom(r);
+	TestReopen(r);
+	TestShrink(r);
+	TestMismatch();
+	::unlink(path);
+	return 0;
+}
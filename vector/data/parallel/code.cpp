@@ -0,0 +1,109 @@
+#include "parallel.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+// 并行算法：1、2、4 个线程下 for_each、transform、reduce、count_if、inclusive_scan、copy_if
+// 与串行结果一致，输出就是输入时结果正确，任务抛出的异常传回调用线程，线程池可反复使用
+
+void TestAlgorithms(size_t threads)
+{
+	std::cout << "Testing with " << threads << " threads..." << std::endl;
+	sjtu::thread_pool pool(threads);
+	sjtu::parallel::options o;
+	o.pool = &pool;
+	o.grain = 1000;
+	const size_t n = 100003;
+	sjtu::vector<long long> v;
+	for (size_t i = 0; i < n; ++i) {
+		v.push_back(static_cast<long long>(i % 1000));
+	}
+
+	sjtu::parallel::for_each(v, [](long long &x) { x = x * 3 + 1; }, o);
+	long long ref = 0;
+	size_t even = 0;
+	for (size_t i = 0; i < n; ++i) {
+		ref += static_cast<long long>(i % 1000) * 3 + 1;
+		even += (i % 1000 * 3 + 1) % 2 == 0;
+	}
+	long long s = sjtu::parallel::reduce(v, 0LL, std::plus<long long>(), o);
+	o.deterministic = true;
+	long long s2 = sjtu::parallel::reduce(v, 0LL, std::plus<long long>(), o);
+	o.deterministic = false;
+	std::cout << "reduce " << s << " " << (s == ref) << " " << (s2 == ref) << std::endl;
+
+	size_t c = sjtu::parallel::count_if(v, [](long long x) { return x % 2 == 0; }, o);
+	std::cout << "count_if " << c << " " << (c == even) << std::endl;
+
+	sjtu::vector<long long> scan;
+	sjtu::parallel::inclusive_scan(v, scan, std::plus<long long>(), o);
+	bool ok = scan.size() == n;
+	long long acc = 0;
+	for (size_t i = 0; ok && i < n; ++i) {
+		acc += v[i];
+		ok = scan[i] == acc;
+	}
+	std::cout << "inclusive_scan " << ok << " " << scan[n - 1] << std::endl;
+
+	sjtu::vector<long long> picked;
+	picked.push_back(-1);
+	sjtu::parallel::copy_if(v, picked, [](long long x) { return x % 7 == 0; }, o);
+	ok = true;
+	size_t k = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (v[i] % 7 == 0) {
+			ok = ok && k < picked.size() && picked[k] == v[i];
+			++k;
+		}
+	}
+	std::cout << "copy_if " << picked.size() << " " << (ok && k == picked.size()) << std::endl;
+
+	sjtu::vector<std::string> text;
+	sjtu::parallel::transform(v, text, [](long long x) { return std::to_string(x); }, o);
+	std::cout << "transform " << text.size() << " " << text[0] << " " << text[n - 1] << std::endl;
+
+	// 输出就是输入
+	sjtu::vector<long long> w(v);
+	sjtu::parallel::transform(w, w, [](long long x) { return x * 2; }, o);
+	sjtu::parallel::inclusive_scan(w, w, std::plus<long long>(), o);
+	std::cout << "in place scan " << (w[n - 1] == ref * 2) << std::endl;
+	sjtu::parallel::copy_if(w, w, [](long long x) { return x % 3 == 0; }, o);
+	ok = true;
+	for (size_t i = 0; i < w.size(); ++i) {
+		ok = ok && w[i] % 3 == 0 && (i == 0 || w[i - 1] < w[i]);
+	}
+	std::cout << "in place copy_if " << w.size() << " " << ok << std::endl;
+
+	try {
+		sjtu::parallel::for_each(v, [](long long &x) {
+			if (x == 1000) {
+				throw std::string("task failed");
+			}
+		}, o);
+		std::cout << "no exception" << std::endl;
+	} catch (std::string &e) {
+		std::cout << e << std::endl;
+	}
+	std::cout << "after exception " << sjtu::parallel::reduce(v, 0LL, std::plus<long long>(), o) << std::endl;
+}
+
+void TestEmpty()
+{
+	std::cout << "Testing empty input..." << std::endl;
+	sjtu::vector<int> e;
+	sjtu::vector<int> out;
+	out.push_back(1);
+	sjtu::parallel::inclusive_scan(e, out);
+	std::cout << sjtu::parallel::reduce(e, 5) << " " << sjtu::parallel::count_if(e, [](int) { return true; }) << " "
+			  << out.size() << std::endl;
+}
+
+int main()
+{
+	TestAlgorithms(1);
+	TestAlgorithms(2);
+	TestAlgorithms(4);
+	TestEmpty();
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include "vector.hpp"
+
+#include <forward_list>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 区间插入、assign、append：输入迭代器（只能走一遍）与前向迭代器两条路径结果一致，
+// 前向迭代器先算出个数，最多重新分配一次
+
+int allocations = 0;
+
+template <class T>
+struct counting_allocator
+{
+	using value_type = T;
+	counting_allocator() {}
+	template <class U>
+	counting_allocator(const counting_allocator<U> &) {}
+	T *allocate(size_t n)
+	{
+		++allocations;
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+	void deallocate(T *p, size_t)
+	{
+		::operator delete(p);
+	}
+	bool operator==(const counting_allocator &) const
+	{
+		return true;
+	}
+	bool operator!=(const counting_allocator &) const
+	{
+		return false;
+	}
+};
+
+using V = sjtu::vector<std::string, sjtu::default_growth_policy, 0, counting_allocator<std::string>>;
+
+bool same(const V &v, const std::vector<std::string> &r)
+{
+	if (v.size() != r.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (v[i] != r[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random range operations..." << std::endl;
+	std::mt19937 rng(6);
+	V a, b;
+	std::vector<std::string> r;
+	bool ok = true;
+	for (int round = 0; round < 300; ++round) {
+		size_t k = rng() % 20;
+		std::string text;
+		std::list<std::string> src;
+		for (size_t i = 0; i < k; ++i) {
+			std::string s = std::to_string(rng() % 1000);
+			text += s + " ";
+			src.push_back(s);
+		}
+		std::istringstream in(text);
+		std::istream_iterator<std::string> first(in), last;
+		int op = static_cast<int>(rng() % 6);
+		if (op < 3) {
+			size_t ind = rng() % (r.size() + 1);
+			V::iterator p = a.insert(ind, first, last);
+			V::iterator q = b.insert(b.begin() + ind, src.begin(), src.end());
+			r.insert(r.begin() + ind, src.begin(), src.end());
+			ok = ok && p - a.begin() == static_cast<long>(ind) && q - b.begin() == static_cast<long>(ind);
+		} else if (op < 5) {
+			a.append(first, last);
+			b.append(src.begin(), src.end());
+			r.insert(r.end(), src.begin(), src.end());
+		} else {
+			a.assign(first, last);
+			b.assign(src.begin(), src.end());
+			r.assign(src.begin(), src.end());
+		}
+		ok = ok && same(a, r) && same(b, r);
+	}
+	std::cout << ok << " " << r.size() << std::endl;
+}
+
+void TestAllocations()
+{
+	std::cout << "Testing allocation counts..." << std::endl;
+	std::forward_list<std::string> src;
+	std::string text;
+	for (int i = 0; i < 1000; ++i) {
+		src.push_front(std::to_string(i));
+		text = std::to_string(i) + " " + text;
+	}
+	V v;
+	v.push_back("x");
+	v.push_back("y");
+	allocations = 0;
+	v.insert(1, src.begin(), src.end()); // 前向迭代器：一次分配
+	std::cout << allocations << " " << v.size() << " " << v[1] << " " << v[1000] << " " << v[1001] << std::endl;
+	allocations = 0;
+	v.append(src.begin(), src.end());
+	std::cout << allocations << " " << v.size() << " " << v.back() << std::endl;
+	allocations = 0;
+	v.assign(src.begin(), src.end()); // 容量够，不分配
+	std::cout << allocations << " " << v.size() << std::endl;
+	// 输入迭代器：先收进临时 vector（逐步增长），再一次插入目标
+	std::istringstream in(text);
+	V w;
+	w.push_back("x");
+	w.push_back("y");
+	allocations = 0;
+	w.insert(1, std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+	std::cout << allocations << " " << w.size() << " " << w[1] << " " << w[1000] << " " << w[1001] << std::endl;
+	// 空区间什么也不做
+	allocations = 0;
+	w.insert(0, src.end(), src.end());
+	std::istringstream empty("");
+	w.append(std::istream_iterator<std::string>(empty), std::istream_iterator<std::string>());
+	std::cout << allocations << " " << w.size() << std::endl;
+}
+
+void TestIntegers()
+{
+	std::cout << "Testing integer ranges..." << std::endl;
+	sjtu::vector<int> v;
+	int arr[] = {1, 2, 3, 4, 5};
+	v.assign(arr, arr + 5);
+	v.insert(2, arr, arr + 3);
+	v.append(arr + 3, arr + 5);
+	std::istringstream in("7 8 9");
+	v.insert(v.begin(), std::istream_iterator<int>(in), std::istream_iterator<int>());
+	v.insert(0, 2, 0); // 两个整数选中 (个数, 值) 重载而不是区间
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << (i + 1 == v.size() ? "\n" : " ");
+	}
+}
+
+int main()
+{
+	TestRandom();
+	TestAllocations();
+	TestIntegers();
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+// 可平凡重定位：插入删除挪动元素、扩容搬移时整块 memmove，不调用移动构造、赋值和析构；
+// 特化了 is_trivially_relocatable 的持有堆指针的类型同样适用，且不泄漏、不重复释放
+
+int moves = 0;
+int assignments = 0;
+int destroyed = 0;
+
+// 只持有一个堆指针，按字节搬到新地址后仍然有效
+template <bool Relocatable>
+struct handle
+{
+	int *p;
+	handle(int v = 0) : p(new int(v)) {}
+	handle(const handle &o) : p(new int(*o.p)) {}
+	handle(handle &&o) noexcept : p(o.p)
+	{
+		o.p = nullptr;
+		++moves;
+	}
+	handle &operator=(const handle &o)
+	{
+		*p = *o.p;
+		++assignments;
+		return *this;
+	}
+	handle &operator=(handle &&o) noexcept
+	{
+		std::swap(p, o.p);
+		++assignments;
+		return *this;
+	}
+	~handle()
+	{
+		delete p;
+		++destroyed;
+	}
+};
+
+namespace sjtu
+{
+	template <>
+	struct is_trivially_relocatable<handle<true>> : std::true_type
+	{
+	};
+}
+
+struct pod
+{
+	int a;
+	double b;
+};
+
+template <bool Relocatable>
+void TestHandles()
+{
+	std::cout << "Testing handles, relocatable = " << Relocatable << "..." << std::endl;
+	std::mt19937 rng(2);
+	sjtu::vector<handle<Relocatable>> v;
+	std::vector<int> r;
+	int erased = 0;
+	moves = assignments = destroyed = 0;
+	for (int i = 0; i < 2000; ++i) {
+		int x = static_cast<int>(rng() % 1000);
+		if (r.empty() || rng() % 3 != 0) {
+			size_t ind = rng() % (r.size() + 1);
+			v.insert(ind, handle<Relocatable>(x)); // 临时对象移动进空位，之后析构
+			r.insert(r.begin() + ind, x);
+		} else {
+			size_t ind = rng() % r.size();
+			v.erase(ind);
+			r.erase(r.begin() + ind);
+			++erased;
+		}
+	}
+	bool ok = v.size() == r.size();
+	for (size_t i = 0; ok && i < r.size(); ++i) {
+		ok = *v[i].p == r[i];
+	}
+	int inserted = 2000 - erased;
+	// 可重定位时：移动只发生在把临时对象放进空位，析构只有临时对象和被删的元素
+	std::cout << ok << " " << (moves == inserted) << " " << (assignments == 0) << " " << (destroyed == inserted + erased)
+			  << std::endl;
+	moves = assignments = destroyed = 0;
+	v.reserve(v.capacity() * 2);
+	v.shrink_to_fit();
+	std::cout << moves << " " << assignments << " " << destroyed << " " << (v.capacity() == v.size()) << std::endl;
+}
+
+void TestPod()
+{
+	std::cout << "Testing trivially copyable..." << std::endl;
+	std::mt19937 rng(20);
+	sjtu::vector<pod> v;
+	std::vector<pod> r;
+	for (int i = 0; i < 5000; ++i) {
+		pod x = {static_cast<int>(rng() % 1000), i * 0.5};
+		int op = static_cast<int>(rng() % 4);
+		if (r.empty() || op < 2) {
+			size_t ind = rng() % (r.size() + 1);
+			v.insert(ind, x);
+			r.insert(r.begin() + ind, x);
+		} else if (op == 2) {
+			size_t ind = rng() % r.size();
+			v.erase(ind);
+			r.erase(r.begin() + ind);
+		} else {
+			// 插入自身元素：memmove 之后源位置已被挪动，必须先拷贝
+			size_t ind = rng() % r.size();
+			v.insert(0, v[ind]);
+			r.insert(r.begin(), pod(r[ind]));
+		}
+	}
+	bool ok = v.size() == r.size();
+	for (size_t i = 0; ok && i < r.size(); ++i) {
+		ok = v[i].a == r[i].a && v[i].b == r[i].b;
+	}
+	std::cout << ok << " " << r.size() << std::endl;
+}
+
+int main()
+{
+	TestHandles<true>();
+	TestHandles<false>();
+	TestPod();
+	return 0;
+}
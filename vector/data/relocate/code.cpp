@@ -0,0 +1,97 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+// 扩容搬移：move 构造不抛异常的类型扩容时只移动不拷贝；move 构造可能抛异常的类型改为拷贝，
+// 拷贝中途抛出时 vector 保持原样（强异常安全）
+
+int copies = 0;
+int moves = 0;
+int copy_limit = -1; // 第几次拷贝时抛出，-1 表示不抛
+
+template <bool NothrowMove>
+struct counted
+{
+	std::string s; // 非平凡类型，不走 memcpy
+	counted(int v = 0) : s(std::to_string(v)) {}
+	counted(const counted &o) : s(o.s)
+	{
+		if (copies == copy_limit) {
+			throw std::string("copy failed");
+		}
+		++copies;
+	}
+	counted(counted &&o) noexcept(NothrowMove) : s(std::move(o.s))
+	{
+		++moves;
+	}
+	counted &operator=(const counted &) = default;
+	counted &operator=(counted &&) = default;
+};
+
+template <bool NothrowMove>
+void TestCounts()
+{
+	std::cout << "Testing reallocation, nothrow move = " << NothrowMove << "..." << std::endl;
+	sjtu::vector<counted<NothrowMove>> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(counted<NothrowMove>(i));
+	}
+	// 以下两次都只换缓冲区，1000 个元素各搬一次
+	copies = moves = 0;
+	v.reserve(v.capacity() * 2);
+	std::cout << v.size() << " " << copies << " " << moves << std::endl;
+	copies = moves = 0;
+	v.shrink_to_fit();
+	std::cout << v.capacity() << " " << copies << " " << moves << " " << v[999].s << std::endl;
+}
+
+void TestStrongGuarantee()
+{
+	std::cout << "Testing strong guarantee..." << std::endl;
+	sjtu::vector<counted<false>> v;
+	v.reserve(8);
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(counted<false>(i));
+	}
+	counted<false> x(100);
+	copies = 0;
+	copy_limit = 5; // 扩容搬到一半时拷贝抛出
+	try {
+		v.push_back(x);
+		std::cout << "no exception" << std::endl;
+	} catch (std::string &e) {
+		std::cout << e << std::endl;
+	}
+	copy_limit = -1;
+	bool ok = v.size() == 8 && v.capacity() == 8;
+	for (int i = 0; i < 8; ++i) {
+		ok = ok && v[i].s == std::to_string(i);
+	}
+	std::cout << ok << std::endl;
+	copies = 0;
+	copy_limit = 3; // 带空位的扩容同样回滚
+	try {
+		v.insert(2, x);
+		std::cout << "no exception" << std::endl;
+	} catch (std::string &e) {
+		std::cout << e << std::endl;
+	}
+	copy_limit = -1;
+	ok = v.size() == 8 && v.capacity() == 8;
+	for (int i = 0; i < 8; ++i) {
+		ok = ok && v[i].s == std::to_string(i);
+	}
+	std::cout << ok << std::endl;
+	v.push_back(x);
+	std::cout << v.size() << " " << v.back().s << std::endl;
+}
+
+int main()
+{
+	TestCounts<true>();
+	TestCounts<false>();
+	TestStrongGuarantee();
+	return 0;
+}
@@ -0,0 +1,140 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// 存档：整块存储和逐个存储的元素、vector<bool> 的往返读写，
+// 以及损坏或伪造的存档（包括从不可定位的流读入）被拒绝，且读档失败不改动原向量
+
+// 只能顺序读取的流缓冲，模拟管道
+struct pipe_buffer : std::streambuf
+{
+	std::string s;
+	size_t p;
+	explicit pipe_buffer(const std::string &s) : s(s), p(0) {}
+	int underflow() override
+	{
+		if (p >= s.size()) {
+			return traits_type::eof();
+		}
+		setg(&s[p], &s[p], &s[p] + 1);
+		++p;
+		return static_cast<unsigned char>(s[p - 1]);
+	}
+};
+
+std::string forge(char kind, bool bitwise, unsigned elem_size, unsigned long long n)
+{
+	std::stringstream ss;
+	sjtu::write_archive_header(ss, kind, bitwise, elem_size, n);
+	return ss.str();
+}
+
+void TestRoundTrip()
+{
+	std::cout << "Testing round trip..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 100000; ++i) {
+		v.push_back(i * i);
+	}
+	std::stringstream ss;
+	v.save(ss);
+	sjtu::vector<long long> w;
+	w.push_back(-1);
+	w.load(ss);
+	bool ok = w.size() == v.size();
+	for (size_t i = 0; ok && i < v.size(); ++i) {
+		ok = w[i] == v[i];
+	}
+	std::cout << w.size() << " " << ok << std::endl;
+
+	sjtu::vector<std::string> s;
+	s.push_back("hello");
+	s.push_back("");
+	s.push_back(std::string(10000, 'z'));
+	std::stringstream ss2;
+	s.save(ss2);
+	sjtu::vector<std::string> t;
+	t.load(ss2);
+	std::cout << t.size() << " " << t[0] << " [" << t[1] << "] " << t[2].size() << std::endl;
+
+	sjtu::vector<bool> b;
+	for (int i = 0; i < 1000; ++i) {
+		b.push_back(i % 7 == 0);
+	}
+	std::stringstream ss3;
+	b.save(ss3);
+	sjtu::vector<bool> c;
+	c.load(ss3);
+	std::cout << c.size() << " " << c.count() << " " << c.find_next(0) << std::endl;
+
+	sjtu::vector<long long> empty;
+	std::stringstream ss4;
+	empty.save(ss4);
+	w.load(ss4);
+	std::cout << w.size() << std::endl;
+}
+
+void TestPipe()
+{
+	std::cout << "Testing non-seekable stream..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 5000; ++i) {
+		v.push_back(i * 3);
+	}
+	std::stringstream ss;
+	v.save(ss);
+	pipe_buffer pb(ss.str());
+	std::istream in(&pb);
+	sjtu::vector<int> w;
+	w.load(in);
+	std::cout << w.size() << " " << w.front() << " " << w.back() << std::endl;
+}
+
+template <class T>
+void expect_reject(const char *name, const std::string &blob, bool pipe)
+{
+	sjtu::vector<T> v;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(T());
+	}
+	std::stringstream ss(blob);
+	pipe_buffer pb(blob);
+	std::istream in(&pb);
+	try {
+		v.load(pipe ? in : static_cast<std::istream &>(ss));
+		std::cout << name << ": accepted" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << name << ": runtime_error, size " << v.size() << std::endl;
+	}
+}
+
+void TestReject()
+{
+	std::cout << "Testing corrupted archives..." << std::endl;
+	expect_reject<long long>("bad magic", "SJTUxx", false);
+	expect_reject<long long>("wrong kind", forge('M', true, 8, 0), false);
+	expect_reject<long long>("wrong element size", forge('V', true, 4, 0), false);
+	expect_reject<long long>("huge count", forge('V', true, 8, 1ULL << 60), false);
+	expect_reject<long long>("huge count from pipe", forge('V', true, 8, 1ULL << 40), true);
+	std::string s = forge('V', true, 8, 3);
+	long long x = 1;
+	s.append(reinterpret_cast<const char *>(&x), sizeof(x));
+	expect_reject<long long>("truncated", s, false);
+
+	std::string str = forge('V', false, 0, 1);
+	unsigned long long len = 1ULL << 50;
+	str.append(reinterpret_cast<const char *>(&len), sizeof(len));
+	str += "abc";
+	expect_reject<std::string>("huge string", str, false);
+	expect_reject<std::string>("huge string from pipe", str, true);
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestPipe();
+	TestReject();
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "simd.hpp"
+
+#include <iostream>
+#include <random>
+
+// 向量化内核：各种长度（含不足一轮和有尾部的）、各种整数宽度和有无符号下，
+// sum、minmax、find、count、dot 与逐个计算的结果一致；空 vector 和长度不同的情况
+
+template <class T>
+bool check(std::mt19937 &rng, size_t n)
+{
+	typedef typename sjtu::simd::accum<T>::type acc_t;
+	sjtu::vector<T> v, w;
+	for (size_t i = 0; i < n; ++i) {
+		unsigned long long bits = (static_cast<unsigned long long>(rng()) << 32) | rng();
+		if (std::is_signed<T>::value && sizeof(T) == 8) {
+			bits = static_cast<unsigned long long>(static_cast<long long>(bits >> 24) - (1LL << 39)); // 累加到 long long 不溢出
+		}
+		v.push_back(rng() % 3 == 0 ? T(rng() % 5) : static_cast<T>(bits));
+		w.push_back(T(rng() % 7));
+	}
+	unsigned long long s = 0, d = 0;
+	for (size_t i = 0; i < n; ++i) {
+		s += static_cast<unsigned long long>(static_cast<acc_t>(v[i])); // 按模 2^64 比较，避免有符号溢出
+		d += static_cast<unsigned long long>(static_cast<acc_t>(v[i])) * static_cast<unsigned long long>(static_cast<acc_t>(w[i]));
+	}
+	bool ok = static_cast<unsigned long long>(sjtu::simd::sum(v)) == s &&
+			  static_cast<unsigned long long>(sjtu::simd::dot(v, w)) == d;
+	const T probes[] = {T(0), T(1), T(4), T(-1)};
+	for (T x : probes) {
+		size_t c = 0, f = n;
+		for (size_t i = 0; i < n; ++i) {
+			if (v[i] == x) {
+				f = c == 0 ? i : f;
+				++c;
+			}
+		}
+		ok = ok && sjtu::simd::count(v, x) == c && sjtu::simd::find(v, x) == f;
+	}
+	if (n > 0) {
+		T lo = v[0], hi = v[0];
+		for (size_t i = 0; i < n; ++i) {
+			lo = v[i] < lo ? v[i] : lo;
+			hi = hi < v[i] ? v[i] : hi;
+		}
+		sjtu::pair<T, T> m = sjtu::simd::minmax(v);
+		ok = ok && m.first == lo && m.second == hi;
+	}
+	return ok;
+}
+
+template <class T>
+void TestType(const char *name)
+{
+	std::mt19937 rng(17);
+	const size_t sizes[] = {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 100, 1000, 4097, 100003};
+	std::cout << name << ":";
+	for (size_t n : sizes) {
+		std::cout << " " << check<T>(rng, n);
+	}
+	std::cout << std::endl;
+}
+
+void TestFloat()
+{
+	std::cout << "Testing floating point..." << std::endl;
+	sjtu::vector<double> v;
+	sjtu::vector<float> f;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i * 0.5);
+		f.push_back(static_cast<float>(i % 10));
+	}
+	v[500] = -3.25;
+	sjtu::pair<double, double> m = sjtu::simd::minmax(v);
+	std::cout << sjtu::simd::sum(v) << " " << m.first << " " << m.second << " " << sjtu::simd::find(v, -3.25) << " "
+			  << sjtu::simd::count(f, 3.0f) << " " << sjtu::simd::dot(f, f) << std::endl;
+}
+
+void TestEdge()
+{
+	std::cout << "Testing edge cases..." << std::endl;
+	sjtu::vector<int> e;
+	std::cout << sjtu::simd::sum(e) << " " << sjtu::simd::find(e, 1) << " " << sjtu::simd::count(e, 1) << std::endl;
+	try {
+		sjtu::simd::minmax(e);
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "minmax of empty: container_is_empty" << std::endl;
+	}
+	sjtu::vector<int> a;
+	a.push_back(1);
+	try {
+		sjtu::simd::dot(a, e);
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "dot of different lengths: runtime_error" << std::endl;
+	}
+	sjtu::vector<unsigned> big;
+	for (int i = 0; i < 100; ++i) {
+		big.push_back(4000000000u);
+	}
+	std::cout << sjtu::simd::sum(big) << std::endl;
+}
+
+int main()
+{
+	std::cout << "Testing integer kernels..." << std::endl;
+	TestType<int>("int");
+	TestType<unsigned>("unsigned");
+	TestType<long>("long");
+	TestType<unsigned long>("unsigned long");
+	TestType<long long>("long long");
+	TestType<unsigned long long>("unsigned long long");
+	TestType<short>("short");
+	TestType<unsigned char>("unsigned char");
+	TestFloat();
+	TestEdge();
+	return 0;
+}
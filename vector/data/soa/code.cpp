@@ -0,0 +1,157 @@
+#include "soa_vector.hpp"
+
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 列存向量：随机插入删除后逐列与 std::vector 比对，迭代器写回，
+// 以及某一列构造抛异常时各列回滚到等长
+
+typedef sjtu::soa_vector<int, std::string, double> table;
+
+struct row
+{
+	int id;
+	std::string name;
+	double score;
+};
+
+bool same(const table &t, const std::vector<row> &r)
+{
+	if (t.size() != r.size() || t.column<0>().size() != r.size() || t.column<1>().size() != r.size() ||
+		t.column<2>().size() != r.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < r.size(); ++i) {
+		if (t.get<0>(i) != r[i].id || t.get<1>(i) != r[i].name || t.get<2>(i) != r[i].score) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	std::mt19937 rng(12);
+	table t;
+	std::vector<row> r;
+	for (int step = 1; step <= 10000; ++step) {
+		int op = rng() % 5;
+		int id = rng() % 1000;
+		row x = {id, std::to_string(id * 7), id * 0.25};
+		if (op < 2) {
+			t.push_back(x.id, x.name, x.score);
+			r.push_back(x);
+		} else if (op == 2) {
+			size_t p = rng() % (r.size() + 1);
+			t.insert(p, x.id, x.name, x.score);
+			r.insert(r.begin() + p, x);
+		} else if (op == 3 && !r.empty()) {
+			size_t p = rng() % r.size();
+			t.erase(t.begin() + p);
+			r.erase(r.begin() + p);
+		} else if (op == 4 && !r.empty()) {
+			t.pop_back();
+			r.pop_back();
+		}
+		if (step % 1000 == 0) {
+			std::cout << t.size() << " " << same(t, r) << std::endl;
+		}
+	}
+	long long sum = 0;
+	for (int v : t.column<0>()) {
+		sum += v;
+	}
+	std::cout << "id sum " << sum << std::endl;
+}
+
+void TestIterator()
+{
+	std::cout << "Testing iterators..." << std::endl;
+	table t;
+	for (int i = 0; i < 10; ++i) {
+		t.emplace_back(i, std::to_string(i), i * 1.5);
+	}
+	for (table::iterator it = t.begin(); it != t.end(); ++it) {
+		std::get<0>(*it) *= 10;
+		std::get<1>(*it) += "!";
+	}
+	const table &ct = t;
+	for (table::const_iterator it = ct.begin(); it != ct.end(); ++it) {
+		std::cout << std::get<0>(*it) << " " << std::get<1>(*it) << " " << std::get<2>(*it) << std::endl;
+	}
+	table copy(t);
+	copy.erase(0);
+	t = copy;
+	std::cout << t.size() << " " << t.get<1>(0) << std::endl;
+	try {
+		t.erase(copy.begin());
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "foreign iterator: invalid_iterator" << std::endl;
+	}
+	t.clear();
+	std::cout << t.empty() << " " << t.column<1>().size() << std::endl;
+}
+
+// 第 limit 次拷贝时抛出异常
+struct fragile
+{
+	static int copies;
+	static int limit;
+	int v;
+	fragile(int v = 0) : v(v) {}
+	fragile(const fragile &other) : v(other.v)
+	{
+		if (++copies == limit) {
+			throw std::runtime_error("copy");
+		}
+	}
+	fragile &operator=(const fragile &) = default;
+};
+int fragile::copies = 0;
+int fragile::limit = -1;
+
+void TestRollback()
+{
+	std::cout << "Testing rollback..." << std::endl;
+	sjtu::soa_vector<int, fragile, std::string> t;
+	t.reserve(16);
+	for (int i = 0; i < 8; ++i) {
+		t.push_back(i, fragile(i), std::to_string(i));
+	}
+	size_t cap = t.capacity();
+	fragile::copies = 0;
+	fragile::limit = 1;
+	try {
+		t.insert(3, 100, fragile(100), std::string("x"));
+		std::cout << "no exception" << std::endl;
+	} catch (std::runtime_error &) {
+		std::cout << "insert threw" << std::endl;
+	}
+	fragile::copies = 0;
+	try {
+		t.push_back(200, fragile(200), std::string("y"));
+		std::cout << "no exception" << std::endl;
+	} catch (std::runtime_error &) {
+		std::cout << "push_back threw" << std::endl;
+	}
+	fragile::limit = -1;
+	std::cout << t.size() << " " << t.column<0>().size() << " " << t.column<1>().size() << " "
+			  << t.column<2>().size() << " " << (t.capacity() == cap) << std::endl;
+	for (size_t i = 0; i < t.size(); ++i) {
+		std::cout << t.get<0>(i) << t.get<1>(i).v << t.get<2>(i) << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestRandom();
+	TestIterator();
+	TestRollback();
+	return 0;
+}
@@ -0,0 +1,175 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 排序：sort、stable_sort、radix_sort 及其并行版本在随机、有序、逆序、大量重复的输入上
+// 与 std::sort / std::stable_sort 结果一致，稳定排序保持相等元素的原顺序，浮点基数排序处理负数
+
+struct item
+{
+	int key;
+	int id;
+};
+
+template <class V>
+bool equal_to_std(const V &v, std::vector<int> ref)
+{
+	std::sort(ref.begin(), ref.end());
+	if (v.size() != ref.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < ref.size(); ++i) {
+		if (v[i] != ref[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestIntegers()
+{
+	std::cout << "Testing integer inputs..." << std::endl;
+	std::mt19937 rng(16);
+	const char *names[] = {"random", "sorted", "reversed", "duplicates", "tiny"};
+	sjtu::thread_pool pool(3);
+	sjtu::parallel::options o;
+	o.pool = &pool;
+	o.grain = 1000;
+	for (int kind = 0; kind < 5; ++kind) {
+		size_t n = kind == 4 ? 7 : 50000;
+		std::vector<int> ref;
+		for (size_t i = 0; i < n; ++i) {
+			int x = static_cast<int>(rng());
+			if (kind == 1) {
+				x = static_cast<int>(i);
+			} else if (kind == 2) {
+				x = static_cast<int>(n - i);
+			} else if (kind == 3) {
+				x = static_cast<int>(rng() % 16);
+			}
+			ref.push_back(x);
+		}
+		sjtu::vector<int> v;
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back(ref[i]);
+		}
+		sjtu::vector<int> a(v), b(v), c(v), d(v), e(v), f(v), g(v), h(v);
+		sjtu::sort(a);
+		sjtu::stable_sort(b);
+		sjtu::radix_sort(c);
+		sjtu::parallel::sort(d, std::less<int>(), o);
+		sjtu::parallel::stable_sort(e, std::less<int>(), o);
+		sjtu::parallel::radix_sort(h, sjtu::detail::radix_identity(), o);
+		sjtu::sort(f.begin(), f.end());
+		sjtu::sort(g.begin(), g.end(), std::greater<int>());
+		bool desc = true;
+		for (size_t i = 1; i < n; ++i) {
+			desc = desc && g[i - 1] >= g[i];
+		}
+		std::cout << names[kind] << " " << equal_to_std(a, ref) << equal_to_std(b, ref) << equal_to_std(c, ref)
+				  << equal_to_std(d, ref) << equal_to_std(e, ref) << equal_to_std(f, ref) << equal_to_std(h, ref) << desc << std::endl;
+	}
+}
+
+void TestStability()
+{
+	std::cout << "Testing stability..." << std::endl;
+	std::mt19937 rng(61);
+	const int n = 30000;
+	std::vector<item> ref;
+	sjtu::vector<item> v;
+	for (int i = 0; i < n; ++i) {
+		item x = {static_cast<int>(rng() % 100) - 50, i};
+		ref.push_back(x);
+		v.push_back(x);
+	}
+	auto by_key = [](const item &x, const item &y) { return x.key < y.key; };
+	std::stable_sort(ref.begin(), ref.end(), by_key);
+	sjtu::vector<item> a(v), b(v), c(v), d(v);
+	sjtu::vector<item> scratch;
+	sjtu::stable_sort(a, by_key, scratch);
+	sjtu::stable_sort(a, by_key, scratch); // 复用缓冲区，已有序时不变
+	sjtu::radix_sort(b, [](const item &x) { return x.key; });
+	sjtu::thread_pool pool(2);
+	sjtu::parallel::options o;
+	o.pool = &pool;
+	o.grain = 500;
+	sjtu::parallel::stable_sort(c, by_key, o);
+	sjtu::parallel::radix_sort(d, [](const item &x) { return x.key; }, o);
+	bool sa = true, sb = true, sc = true, sd = true;
+	for (int i = 0; i < n; ++i) {
+		sa = sa && a[i].id == ref[i].id;
+		sb = sb && b[i].id == ref[i].id;
+		sc = sc && c[i].id == ref[i].id;
+		sd = sd && d[i].id == ref[i].id;
+	}
+	std::cout << sa << " " << sb << " " << sc << " " << sd << " " << a[0].key << " " << a[n - 1].key << std::endl;
+}
+
+void TestFloats()
+{
+	std::cout << "Testing floating point keys..." << std::endl;
+	std::mt19937 rng(160);
+	sjtu::vector<double> d;
+	sjtu::vector<float> f;
+	for (int i = 0; i < 20000; ++i) {
+		int x = static_cast<int>(rng() % 2000001) - 1000000;
+		d.push_back(x / 7.0);
+		f.push_back(static_cast<float>(x) / 1000.0f);
+	}
+	d.push_back(-0.0);
+	d.push_back(0.0);
+	d.push_back(-1e300);
+	d.push_back(1e300);
+	sjtu::vector<double> pd(d);
+	sjtu::vector<float> pf(f);
+	sjtu::radix_sort(d);
+	sjtu::radix_sort(f);
+	sjtu::thread_pool pool(4);
+	sjtu::parallel::options o;
+	o.pool = &pool;
+	o.grain = 3000;
+	sjtu::parallel::radix_sort(pd, sjtu::detail::radix_identity(), o);
+	sjtu::parallel::radix_sort(pf, sjtu::detail::radix_identity(), o);
+	bool ok = true;
+	for (size_t i = 1; i < d.size(); ++i) {
+		ok = ok && !(d[i] < d[i - 1]) && pd[i] == d[i] && std::signbit(pd[i]) == std::signbit(d[i]);
+	}
+	for (size_t i = 1; i < f.size(); ++i) {
+		ok = ok && !(f[i] < f[i - 1]) && pf[i] == f[i];
+	}
+	std::cout << ok << " " << d.front() << " " << d.back() << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing strings..." << std::endl;
+	std::mt19937 rng(1600);
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 5000; ++i) {
+		s.push_back(std::to_string(rng() % 1000));
+	}
+	sjtu::vector<std::string> t(s);
+	sjtu::sort(s);
+	sjtu::stable_sort(t);
+	bool ok = true;
+	for (size_t i = 1; i < s.size(); ++i) {
+		ok = ok && !(s[i] < s[i - 1]) && s[i] == t[i];
+	}
+	std::cout << ok << " " << s.front() << " " << s.back() << std::endl;
+}
+
+int main()
+{
+	TestIntegers();
+	TestStability();
+	TestFloats();
+	TestStrings();
+	return 0;
+}
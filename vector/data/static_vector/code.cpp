@@ -0,0 +1,176 @@
+#include "static_vector.hpp"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// 定容向量：编译期使用（static_assert 检查结果）、两种溢出策略（抛异常、abort），
+// 以及需要析构的元素的构造、析构次数
+
+// 可平凡析构但有默认成员初值和 constexpr 构造函数的类型，也走字面类型的存储
+struct point
+{
+	int x = 1;
+	int y = 2;
+	constexpr point() = default;
+	constexpr point(int x, int y) : x(x), y(y) {}
+};
+
+constexpr int constexpr_ints()
+{
+	sjtu::static_vector<int, 8> v;
+	for (int i = 1; i <= 5; ++i) {
+		v.push_back(i * i);
+	}
+	v.erase(0);
+	v.insert(1, 100);
+	v.pop_back();
+	sjtu::static_vector<int, 8> w(v);
+	int s = 0;
+	for (int x : w) {
+		s += x;
+	}
+	return s * 10 + static_cast<int>(w.size());
+}
+
+constexpr int constexpr_points()
+{
+	sjtu::static_vector<point, 4> v;
+	v.emplace_back(3, 4);
+	v.emplace_back();
+	v.push_back(point(5, 6));
+	return v[0].x * 1000 + v[1].y * 100 + v[2].x * 10 + static_cast<int>(v.size());
+}
+
+static_assert(constexpr_ints() == (4 + 100 + 9 + 16) * 10 + 4, "static_vector<int> in a constant expression");
+static_assert(constexpr_points() == 3000 + 200 + 50 + 3, "static_vector<point> in a constant expression");
+static_assert(sjtu::static_vector_literal<point>::value, "trivially destructible types use the literal storage");
+static_assert(!sjtu::static_vector_literal<std::string>::value, "types with destructors use raw storage");
+
+// 统计构造、析构次数的元素
+struct tracked
+{
+	static int constructed;
+	static int destroyed;
+	int v;
+	tracked(int v = 0) : v(v)
+	{
+		++constructed;
+	}
+	tracked(const tracked &o) : v(o.v)
+	{
+		++constructed;
+	}
+	tracked(tracked &&o) noexcept : v(o.v)
+	{
+		++constructed;
+	}
+	tracked &operator=(const tracked &) = default;
+	tracked &operator=(tracked &&) = default;
+	~tracked()
+	{
+		++destroyed;
+	}
+};
+int tracked::constructed = 0;
+int tracked::destroyed = 0;
+
+void TestConstexpr()
+{
+	std::cout << "Testing constexpr use..." << std::endl;
+	constexpr int a = constexpr_ints();
+	constexpr int b = constexpr_points();
+	std::cout << a << " " << b << std::endl;
+}
+
+void TestThrow()
+{
+	std::cout << "Testing throw_on_overflow..." << std::endl;
+	sjtu::static_vector<std::string, 3> v;
+	v.push_back("a");
+	v.push_back("b");
+	v.push_back("c");
+	try {
+		v.push_back("d");
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "push_back: index_out_of_bound" << std::endl;
+	}
+	try {
+		v.insert(0, "e");
+		std::cout << "no exception" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "insert: index_out_of_bound" << std::endl;
+	}
+	std::cout << v.size() << " " << v.full() << " " << v[0] << v[1] << v[2] << std::endl;
+}
+
+// 溢出时进程应被 SIGABRT 终止，放到子进程里验证
+void TestAbort()
+{
+	std::cout << "Testing assert_on_overflow..." << std::endl;
+	std::cout.flush();
+	pid_t pid = ::fork();
+	if (pid == 0) {
+		::close(2); // 断言信息不进入输出
+		sjtu::static_vector<int, 2, sjtu::assert_on_overflow> v;
+		v.push_back(1);
+		v.push_back(2);
+		v.push_back(3);
+		::_exit(0);
+	}
+	int status = 0;
+	::waitpid(pid, &status, 0);
+	std::cout << (WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT) << std::endl;
+	sjtu::static_vector<int, 2, sjtu::assert_on_overflow> w;
+	w.push_back(1);
+	w.push_back(2);
+	std::cout << w.size() << " " << w.full() << std::endl;
+}
+
+void TestCounts()
+{
+	std::cout << "Testing construct/destroy counts..." << std::endl;
+	{
+		sjtu::static_vector<tracked, 16> v;
+		std::cout << tracked::constructed << " " << tracked::destroyed << std::endl; // 未用的位置不构造
+		for (int i = 0; i < 10; ++i) {
+			v.emplace_back(i);
+		}
+		std::cout << tracked::constructed << " " << tracked::destroyed << std::endl;
+		v.insert(3, tracked(100));
+		v.erase(0);
+		v.pop_back();
+		std::cout << tracked::constructed - tracked::destroyed << " " << v.size() << std::endl;
+		sjtu::static_vector<tracked, 16> w(v);
+		sjtu::static_vector<tracked, 16> x(std::move(w));
+		w = x;
+		x.clear();
+		std::cout << tracked::constructed - tracked::destroyed << " " << v.size() + w.size() + x.size() << std::endl;
+		sjtu::static_vector<tracked, 2> full;
+		full.emplace_back(1);
+		full.emplace_back(2);
+		int before = tracked::constructed - tracked::destroyed;
+		try {
+			full.emplace_back(3);
+		} catch (sjtu::index_out_of_bound &) {
+			std::cout << "overflow: " << (tracked::constructed - tracked::destroyed == before) << std::endl;
+		}
+		for (size_t i = 0; i < v.size(); ++i) {
+			std::cout << v[i].v << (i + 1 == v.size() ? "\n" : " ");
+		}
+	}
+	std::cout << (tracked::constructed == tracked::destroyed) << std::endl;
+}
+
+int main()
+{
+	TestConstexpr();
+	TestThrow();
+	TestAbort();
+	TestCounts();
+	return 0;
+}
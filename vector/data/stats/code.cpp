@@ -0,0 +1,136 @@
+#define SJTU_VECTOR_STATS
+#include "vector.hpp"
+
+#include <iostream>
+
+// 分配统计：打开 SJTU_VECTOR_STATS 后，按已知的 push_back / insert 序列核对
+// 分配、释放、换缓冲区、搬移、挪动的精确次数，并与元素自己记下的拷贝、移动次数对照
+
+struct counted
+{
+	static int copies;		 // 拷贝构造
+	static int moves;		 // 移动构造
+	static int assignments; // 拷贝和移动赋值
+	int v;
+	counted(int v = 0) : v(v) {}
+	counted(const counted &o) : v(o.v)
+	{
+		++copies;
+	}
+	counted(counted &&o) noexcept : v(o.v)
+	{
+		++moves;
+	}
+	counted &operator=(const counted &o)
+	{
+		v = o.v;
+		++assignments;
+		return *this;
+	}
+	counted &operator=(counted &&o) noexcept
+	{
+		v = o.v;
+		++assignments;
+		return *this;
+	}
+	static void reset()
+	{
+		copies = moves = assignments = 0;
+	}
+};
+int counted::copies = 0;
+int counted::moves = 0;
+int counted::assignments = 0;
+
+void print(const sjtu::stats::vector_counters &c)
+{
+	std::cout << "alloc " << c.allocations << " dealloc " << c.deallocations << " realloc " << c.reallocations
+			  << " relocated " << c.relocated << " bytes " << c.relocated_bytes << " shifted " << c.shifted
+			  << " peak " << c.peak_capacity << std::endl;
+}
+
+void TestPushBack()
+{
+	std::cout << "Testing push_back..." << std::endl;
+	sjtu::stats::reset_vector();
+	counted::reset();
+	sjtu::vector<counted> v;
+	// 容量 0 -> 2 -> 4 -> 8 -> 16：4 次分配，搬移 0 + 2 + 4 + 8 = 14 个元素
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(counted(i));
+	}
+	print(v.stats());
+	// 每次 push_back 移动一次，换缓冲区时每个元素再移动一次，没有拷贝
+	std::cout << counted::copies << " " << counted::moves << " " << counted::assignments << std::endl;
+}
+
+void TestInsert()
+{
+	std::cout << "Testing insert..." << std::endl;
+	sjtu::vector<counted> v;
+	v.reserve(8);
+	for (int i = 0; i < 7; ++i) {
+		v.push_back(counted(i));
+	}
+	counted::reset();
+	counted x(100);
+	// 容量够：原地挪动 7 个元素（1 个移动构造到新尾部，6 个移动赋值）；x 先拷贝一份以防引用自身元素，再移动进空位
+	v.insert(0, x);
+	print(v.stats());
+	std::cout << counted::copies << " " << counted::moves << " " << counted::assignments << std::endl;
+	counted::reset();
+	// 已满时插入：换到容量 16 的缓冲区，同时在下标 3 留空位，8 个元素只各移动一次，不再挪动；x 同样拷贝一次、移动一次
+	v.insert(3, x);
+	print(v.stats());
+	std::cout << counted::copies << " " << counted::moves << " " << counted::assignments << " " << v.capacity() << std::endl;
+	counted::reset();
+	// 删除首元素：挪动其后 8 个元素，1 个移动构造进被析构的位置，其余 7 个移动赋值
+	v.erase(0);
+	print(v.stats());
+	std::cout << counted::copies << " " << counted::moves << " " << counted::assignments << std::endl;
+}
+
+void TestTrivial()
+{
+	std::cout << "Testing trivially relocatable..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	v.insert(50, -1);
+	v.shrink_to_fit();
+	// 0 -> 2 -> ... -> 128 共 7 次，shrink_to_fit 到 101 再一次；按字节计 4 倍
+	print(v.stats());
+	sjtu::vector<int> w(v); // 拷贝出的对象从 0 开始计
+	print(w.stats());
+}
+
+void TestTotals()
+{
+	std::cout << "Testing process totals..." << std::endl;
+	sjtu::stats::reset_vector();
+	sjtu::vector<int> a, b;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(i);
+		b.push_back(i);
+		b.push_back(i);
+	}
+	sjtu::stats::vector_counters ca = a.stats(), cb = b.stats(), t = sjtu::stats::vector();
+	print(t);
+	std::cout << (t.allocations == ca.allocations + cb.allocations) << (t.relocated == ca.relocated + cb.relocated)
+			  << (t.peak_capacity == cb.peak_capacity) << std::endl;
+	{
+		sjtu::vector<int> c(a);
+	}
+	std::cout << sjtu::stats::vector().deallocations - t.deallocations << std::endl;
+}
+
+int main()
+{
+	std::cout << sjtu::stats::enabled << std::endl;
+	TestPushBack();
+	TestInsert();
+	TestTrivial();
+	TestTotals();
+	return 0;
+}
@@ -0,0 +1,155 @@
+#ifndef SJTU_ARENA_HPP
+#define SJTU_ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// 单调内存池：从大块内存中顺序切分，单次释放无操作，release() 或析构时一次性归还
+namespace sjtu
+{
+	class monotonic_arena
+	{
+	private:
+		struct Block
+		{
+			Block *next;
+			size_t size; // 含块头在内的字节数
+		};
+
+		Block *head;	   // 最近申请的块
+		char *cur;		   // 当前块中下一个可用位置
+		char *end;		   // 当前块末尾
+		size_t block_size; // 普通块大小
+		size_t used_;	   // 已切分出去的字节数
+
+		static size_t header_size()
+		{
+			return (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+		}
+
+		Block *new_block(size_t bytes)
+		{
+			Block *b = static_cast<Block *>(std::malloc(bytes));
+			if (b == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+			b->size = bytes;
+			return b;
+		}
+
+	public:
+		explicit monotonic_arena(size_t block_size_ = 64 * 1024)
+			: head(nullptr), cur(nullptr), end(nullptr), block_size(block_size_), used_(0) {}
+		monotonic_arena(const monotonic_arena &) = delete;
+		monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+		~monotonic_arena()
+		{
+			release();
+		}
+
+		void *allocate(size_t bytes, size_t align)
+		{
+			if (bytes > static_cast<size_t>(-1) - header_size() - align) // 下面算块大小时会溢出
+			{
+				throw std::bad_alloc();
+			}
+			size_t pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+			if (cur == nullptr || pad + bytes > static_cast<size_t>(end - cur))
+			{
+				size_t need = header_size() + bytes + align;
+				if (need > block_size) // 大对象单独成块，挂在当前块之后，不打断当前块的切分
+				{
+					Block *b = new_block(need);
+					if (head == nullptr)
+					{
+						b->next = nullptr;
+						head = b;
+					}
+					else
+					{
+						b->next = head->next;
+						head->next = b;
+					}
+					char *p = reinterpret_cast<char *>(b) + header_size();
+					p += (align - reinterpret_cast<size_t>(p) % align) % align;
+					used_ += bytes;
+					return p;
+				}
+				Block *b = new_block(block_size);
+				b->next = head;
+				head = b;
+				cur = reinterpret_cast<char *>(b) + header_size();
+				end = reinterpret_cast<char *>(b) + block_size;
+				pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+			}
+			char *p = cur + pad;
+			cur = p + bytes;
+			used_ += bytes;
+			return p;
+		}
+
+		// 归还全部内存，之前分配出去的指针全部失效
+		void release()
+		{
+			while (head != nullptr)
+			{
+				Block *next = head->next;
+				std::free(head);
+				head = next;
+			}
+			cur = end = nullptr;
+			used_ = 0;
+		}
+
+		size_t used() const
+		{
+			return used_;
+		}
+	};
+
+	// 从 monotonic_arena 取内存的空间配置器，deallocate 为空操作；
+	// 拷贝出的配置器共享同一个 arena，容器拷贝后仍在同一 arena 中
+	template <typename T>
+	class arena_allocator
+	{
+	private:
+		template <typename U>
+		friend class arena_allocator;
+
+		monotonic_arena *arena;
+
+	public:
+		using value_type = T;
+
+		arena_allocator(monotonic_arena &a) noexcept : arena(&a) {}
+		template <typename U>
+		arena_allocator(const arena_allocator<U> &other) noexcept : arena(other.arena) {}
+
+		T *allocate(size_t n)
+		{
+			if (n > static_cast<size_t>(-1) / sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+			return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T *, size_t) noexcept {}
+
+		template <typename U>
+		bool operator==(const arena_allocator<U> &rhs) const noexcept
+		{
+			return arena == rhs.arena;
+		}
+		template <typename U>
+		bool operator!=(const arena_allocator<U> &rhs) const noexcept
+		{
+			return arena != rhs.arena;
+		}
+	};
+
+}
+
+#endif
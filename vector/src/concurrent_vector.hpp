@@ -0,0 +1,236 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+// 并发追加向量：元素存放在按 2 的幂增长的分段中，分段一经分配从不搬动，元素地址始终稳定。
+// push_back 先备好下标所在的段再用 CAS 领取下标，构造完成后标记就绪，并顺带把“已发布前缀”向前推进，
+// 任何线程都能替别人推进，因此不需要锁。size() 只统计从 0 开始连续就绪的元素，
+// 下标小于 size() 的元素可被任意线程并发读取。clear 和析构不能与其他操作并发
+namespace sjtu
+{
+	template <typename T>
+	class concurrent_vector
+	{
+		static_assert(std::is_nothrow_move_constructible<T>::value,
+					  "a claimed slot must always be filled, so moving T into it must not throw");
+		static_assert(alignof(T) <= alignof(std::max_align_t), "segments come from malloc");
+
+	private:
+		struct slot
+		{
+			alignas(T) unsigned char buf[sizeof(T)];
+			std::atomic<bool> ready;
+
+			slot() : ready(false) {}
+
+			T *ptr()
+			{
+				return reinterpret_cast<T *>(buf);
+			}
+		};
+
+		static const size_t base_bits = 5; // 第 0 段 32 个元素，之后每段翻倍
+		static const size_t max_segments = sizeof(size_t) * CHAR_BIT - base_bits;
+
+		std::atomic<slot *> segs[max_segments]; // 分段表
+		std::atomic<size_t> claimed;			  // 已领取的下标数
+		std::atomic<size_t> size_;				  // 已发布的元素数
+
+		static size_t floor_log2(size_t x) // 要求 x != 0
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(x);
+#else
+			size_t r = 0;
+			while (x >>= 1)
+			{
+				++r;
+			}
+			return r;
+#endif
+		}
+		// 下标 i 所在的段号和段内偏移
+		static size_t segment_of(size_t i, size_t &off)
+		{
+			size_t j = i + (size_t(1) << base_bits);
+			size_t k = floor_log2(j) - base_bits;
+			off = j - (size_t(1) << (k + base_bits));
+			return k;
+		}
+		static size_t segment_size(size_t k)
+		{
+			return size_t(1) << (k + base_bits);
+		}
+
+		// 某个线程正在分配该段时段表里的占位值
+		static slot *pending()
+		{
+			return reinterpret_cast<slot *>(std::uintptr_t(1));
+		}
+
+		// 取得第 k 段，尚未分配时分配。只有把段表项从空换成占位值的线程去分配并逐个构造槽位，
+		// 其余线程让出 CPU 等它完成，免得大段被多个线程重复构造；分配失败时恢复为空再抛出
+		slot *segment(size_t k)
+		{
+			slot *s = segs[k].load(std::memory_order_acquire);
+			while (s == nullptr || s == pending())
+			{
+				if (s == nullptr && segs[k].compare_exchange_weak(s, pending(), std::memory_order_acquire))
+				{
+					size_t n = segment_size(k);
+					slot *fresh = static_cast<slot *>(std::malloc(n * sizeof(slot)));
+					if (fresh == nullptr)
+					{
+						segs[k].store(nullptr, std::memory_order_release);
+						throw std::bad_alloc();
+					}
+					for (size_t j = 0; j < n; ++j)
+					{
+						new (fresh + j) slot();
+					}
+					segs[k].store(fresh, std::memory_order_release);
+					return fresh;
+				}
+				if (s == pending())
+				{
+					std::this_thread::yield();
+					s = segs[k].load(std::memory_order_acquire);
+				}
+			}
+			return s;
+		}
+		slot &slot_at(size_t i) const
+		{
+			size_t off;
+			size_t k = segment_of(i, off);
+			return segs[k].load(std::memory_order_acquire)[off];
+		}
+
+		// 第 i 个位置已构造完成；要求 i < claimed，此时所在段必已分配
+		bool is_ready(size_t i) const
+		{
+			return slot_at(i).ready.load();
+		}
+
+		// 把已发布前缀推进到第一个未就绪的位置
+		void publish()
+		{
+			size_t s = size_.load();
+			while (s < claimed.load() && is_ready(s))
+			{
+				if (size_.compare_exchange_weak(s, s + 1))
+				{
+					++s;
+				}
+			}
+		}
+
+	public:
+		concurrent_vector() : claimed(0), size_(0)
+		{
+			for (size_t k = 0; k < max_segments; ++k)
+			{
+				segs[k].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+		concurrent_vector(const concurrent_vector &) = delete;
+		concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+		~concurrent_vector()
+		{
+			clear();
+			for (size_t k = 0; k < max_segments; ++k)
+			{
+				std::free(segs[k].load(std::memory_order_relaxed));
+			}
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size_.load())
+			{
+				throw index_out_of_bound();
+			}
+			return *slot_at(pos).ptr();
+		}
+		const T &at(const size_t &pos) const
+		{
+			if (pos >= size_.load())
+			{
+				throw index_out_of_bound();
+			}
+			return *slot_at(pos).ptr();
+		}
+		T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		// 已发布的元素个数
+		size_t size() const
+		{
+			return size_.load();
+		}
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		// 追加一个元素并返回其下标，下标从此不变；先在调用线程构造好，构造失败时不占用下标。
+		// 领取下标前先确保它所在的段已分配，分配抛出 bad_alloc 时同样不占用下标，
+		// 否则留下的空位会让 publish 永远停在那里
+		template <class... Args>
+		size_t emplace_back(Args &&...args)
+		{
+			T tmp(std::forward<Args>(args)...);
+			size_t i = claimed.load();
+			size_t off;
+			slot *seg;
+			do
+			{
+				seg = segment(segment_of(i, off));
+			} while (!claimed.compare_exchange_weak(i, i + 1));
+			slot &s = seg[off];
+			new (s.ptr()) T(std::move(tmp));
+			s.ready.store(true);
+			publish();
+			return i;
+		}
+		size_t push_back(const T &value)
+		{
+			return emplace_back(value);
+		}
+		size_t push_back(T &&value)
+		{
+			return emplace_back(std::move(value));
+		}
+
+		// 析构全部元素，保留已分配的分段
+		void clear()
+		{
+			size_t n = claimed.load();
+			for (size_t i = 0; i < n; ++i)
+			{
+				slot &s = slot_at(i);
+				s.ptr()->~T();
+				s.ready.store(false, std::memory_order_relaxed);
+			}
+			claimed.store(0);
+			size_.store(0);
+		}
+	};
+
+}
+
+#endif
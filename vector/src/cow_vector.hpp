@@ -0,0 +1,322 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+
+// 写时复制向量：拷贝只让引用计数加一，多个副本共享同一块缓冲区，直到某个副本第一次修改时才深拷贝。
+// 引用计数是原子的，不同线程可以各自持有、拷贝、读取共享同一缓冲区的副本（同一对象仍不可并发修改）。
+// const 接口不检查共享状态，const 迭代器就是 const T *；非 const 的 begin()/end()/at()/operator[]
+// 会先取得独占缓冲区，并像旧式写时复制字符串一样把它标记为不可共享：之后拷贝该对象都深拷贝，
+// 交出去的引用和迭代器不会写到副本里。标记一直保留到对象被重新赋值或 clear()
+namespace sjtu
+{
+	template <typename T, class Policy = default_growth_policy>
+	class cow_vector
+	{
+	public:
+		using iterator = T *;
+		using const_iterator = const T *;
+
+	private:
+		struct rep
+		{
+			std::atomic<size_t> refs; // 共享此缓冲区的对象数
+			bool shareable;			  // 交出过可写引用后为 false，只会在 refs == 1 时被改动
+			vector<T, Policy> items;
+
+			rep() : refs(1), shareable(true) {}
+			explicit rep(const vector<T, Policy> &other) : refs(1), shareable(true), items(other) {}
+			// 拷贝 other 的元素，容量一次分配到至少 cap
+			rep(const vector<T, Policy> &other, size_t cap) : refs(1), shareable(true)
+			{
+				items.reserve(cap);
+				for (size_t i = 0; i < other.size(); ++i)
+				{
+					items.push_back(other[i]);
+				}
+			}
+		};
+
+		rep *r; // 为空表示空向量，不占堆内存
+
+		void release()
+		{
+			if (r != nullptr && r->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete r;
+			}
+			r = nullptr;
+		}
+
+		// 拷贝时取得的缓冲区：可共享就加引用计数，否则深拷贝
+		static rep *share(rep *other)
+		{
+			if (other == nullptr)
+			{
+				return nullptr;
+			}
+			if (!other->shareable)
+			{
+				return new rep(other->items);
+			}
+			other->refs.fetch_add(1, std::memory_order_relaxed);
+			return other;
+		}
+
+		// 修改前调用：保证缓冲区只属于自己且容量至少为 cap，共享时按所需容量深拷贝一份，只分配一次
+		vector<T, Policy> &mutate(size_t cap = 0)
+		{
+			if (r == nullptr)
+			{
+				r = new rep();
+			}
+			else if (r->refs.load(std::memory_order_acquire) != 1)
+			{
+				rep *own = cap > r->items.size() ? new rep(r->items, cap) : new rep(r->items);
+				release();
+				r = own;
+			}
+			r->items.reserve(cap);
+			return r->items;
+		}
+		// 再放 n 个元素所需的容量：放得下就是当前容量，否则按扩容策略增长。
+		// 作为 mutate 的参数，共享时深拷贝直接分配到这么大，之后的插入不必再扩容
+		size_t room_for(size_t n) const
+		{
+			size_t need = size() + n;
+			size_t cap = capacity();
+			if (need <= cap)
+			{
+				return cap;
+			}
+			size_t grown = Policy::grow(cap);
+			return grown > need ? grown : need;
+		}
+		// 交出可写引用或迭代器前调用
+		vector<T, Policy> &leak(size_t cap = 0)
+		{
+			vector<T, Policy> &v = mutate(cap);
+			r->shareable = false;
+			return v;
+		}
+
+		T *mutable_data()
+		{
+			vector<T, Policy> &v = leak();
+			return v.empty() ? nullptr : &v[0];
+		}
+
+	public:
+		cow_vector() : r(nullptr) {}
+		cow_vector(const cow_vector &other) : r(share(other.r)) {}
+		cow_vector(cow_vector &&other) noexcept : r(other.r)
+		{
+			other.r = nullptr;
+		}
+		// 从普通 vector 拷贝一次，之后的拷贝都是共享
+		explicit cow_vector(const vector<T, Policy> &other) : r(new rep(other)) {}
+
+		~cow_vector()
+		{
+			release();
+		}
+
+		cow_vector &operator=(const cow_vector &other)
+		{
+			if (r == other.r)
+			{
+				return *this;
+			}
+			rep *got = share(other.r);
+			release();
+			r = got;
+			return *this;
+		}
+		cow_vector &operator=(cow_vector &&other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			release();
+			r = other.r;
+			other.r = nullptr;
+			return *this;
+		}
+
+		// 共享当前缓冲区的对象个数，空向量为 0
+		size_t use_count() const
+		{
+			return r == nullptr ? 0 : r->refs.load(std::memory_order_acquire);
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size())
+			{
+				throw index_out_of_bound();
+			}
+			return leak()[pos];
+		}
+		const T &at(const size_t &pos) const
+		{
+			if (pos >= size())
+			{
+				throw index_out_of_bound();
+			}
+			return r->items[pos];
+		}
+		T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		const T &front() const
+		{
+			if (empty())
+			{
+				throw container_is_empty();
+			}
+			return r->items.front();
+		}
+		const T &back() const
+		{
+			if (empty())
+			{
+				throw container_is_empty();
+			}
+			return r->items.back();
+		}
+
+		iterator begin()
+		{
+			return mutable_data();
+		}
+		const_iterator begin() const
+		{
+			return cbegin();
+		}
+		const_iterator cbegin() const
+		{
+			return empty() ? nullptr : &r->items[0];
+		}
+		iterator end()
+		{
+			return mutable_data() + size();
+		}
+		const_iterator end() const
+		{
+			return cend();
+		}
+		const_iterator cend() const
+		{
+			return cbegin() + size();
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+		size_t size() const
+		{
+			return r == nullptr ? 0 : r->items.size();
+		}
+		size_t capacity() const
+		{
+			return r == nullptr ? 0 : r->items.capacity();
+		}
+
+		void reserve(size_t n)
+		{
+			if (n > capacity())
+			{
+				mutate(n);
+			}
+		}
+		void shrink_to_fit()
+		{
+			if (r != nullptr)
+			{
+				mutate().shrink_to_fit();
+			}
+		}
+		// 共享时只解除共享，不拷贝元素
+		void clear()
+		{
+			if (use_count() > 1)
+			{
+				release();
+				return;
+			}
+			if (r != nullptr)
+			{
+				r->items.clear();
+				r->shareable = true;
+			}
+		}
+
+		// 迭代器就是指针，写成模板以免字面量 0 与下标重载产生歧义
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value || std::is_same<It, const_iterator>::value>::type>
+		iterator insert(It pos, const T &value)
+		{
+			return insert(static_cast<size_t>(pos - cbegin()), value);
+		}
+		iterator insert(const size_t &ind, const T &value)
+		{
+			if (ind > size())
+			{
+				throw index_out_of_bound();
+			}
+			leak(room_for(1)).insert(ind, value);
+			return &r->items[ind];
+		}
+
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value || std::is_same<It, const_iterator>::value>::type>
+		iterator erase(It pos)
+		{
+			return erase(static_cast<size_t>(pos - cbegin()));
+		}
+		iterator erase(const size_t &ind)
+		{
+			if (ind >= size())
+			{
+				throw index_out_of_bound();
+			}
+			vector<T, Policy> &v = leak();
+			v.erase(ind);
+			return (v.empty() ? nullptr : &v[0]) + ind;
+		}
+
+		template <class... Args>
+		T &emplace_back(Args &&...args)
+		{
+			return leak(room_for(1)).emplace_back(std::forward<Args>(args)...);
+		}
+		void push_back(const T &value)
+		{
+			mutate(room_for(1)).push_back(value);
+		}
+		void push_back(T &&value)
+		{
+			mutate(room_for(1)).push_back(std::move(value));
+		}
+
+		void pop_back()
+		{
+			if (empty())
+			{
+				throw container_is_empty();
+			}
+			mutate().pop_back();
+		}
+	};
+
+}
+
+#endif
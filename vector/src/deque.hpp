@@ -0,0 +1,584 @@
+#ifndef SJTU_DEQUE_HPP
+#define SJTU_DEQUE_HPP
+
+#include "devector.hpp"
+
+// 分块双端队列：元素存放在定长块中，块指针表用 devector 维护，块、块表和块缓存都经由同一个空间配置器分配。
+// 头尾增删只搬动块指针、不搬动元素，因此元素的指针和引用在头尾增删后仍然有效；
+// 空出的块先放进缓存，稳定的头尾进出不再向系统申请内存
+namespace sjtu
+{
+	template <typename T, class Alloc = std::allocator<T>>
+	class deque
+	{
+	public:
+		static const size_t block_size = sizeof(T) <= 256 ? 4096 / sizeof(T) : 16; // 每块元素个数
+
+	private:
+		using alloc_traits = std::allocator_traits<Alloc>;
+		using ptr_alloc = typename alloc_traits::template rebind_alloc<T *>;
+
+		devector<T *, default_growth_policy, ptr_alloc> map;	// 正在使用的块，map[0] 为首块
+		vector<T *, default_growth_policy, 0, ptr_alloc> cache; // 空闲块缓存
+		size_t start;		// 首元素在首块中的下标
+		size_t size_;		// 元素个数
+		Alloc alloc;		// 空间配置器
+
+		T *acquire_block()
+		{
+			if (!cache.empty())
+			{
+				T *blk = cache.back();
+				cache.pop_back();
+				return blk;
+			}
+			return alloc_traits::allocate(alloc, block_size);
+		}
+		// 缓存数量不超过使用中的块数（至少留两块），多余的直接归还
+		void release_block(T *blk)
+		{
+			if (cache.size() < map.size() || cache.size() < 2)
+			{
+				cache.push_back(blk);
+				return;
+			}
+			alloc_traits::deallocate(alloc, blk, block_size);
+		}
+		void free_cache()
+		{
+			while (!cache.empty())
+			{
+				alloc_traits::deallocate(alloc, cache.back(), block_size);
+				cache.pop_back();
+			}
+		}
+		void destroy_all()
+		{
+			while (size_ != 0)
+			{
+				pop_back();
+			}
+		}
+
+	public:
+		class const_iterator;
+		class iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = T;
+			using pointer = T *;
+			using reference = T &;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class deque;
+			friend class const_iterator;
+
+			T **node;	// 所在块在块表中的位置
+			size_t off; // 块内下标，始终小于 block_size
+
+		public:
+			iterator() : node(nullptr), off(0) {}
+			iterator(T **node_, size_t off_) : node(node_), off(off_) {}
+
+			iterator &operator+=(const difference_type &n)
+			{
+				difference_type pos = static_cast<difference_type>(off) + n;
+				difference_type bs = static_cast<difference_type>(block_size);
+				difference_type step = pos >= 0 ? pos / bs : -((-pos - 1) / bs) - 1;
+				node += step;
+				off = static_cast<size_t>(pos - step * bs);
+				return *this;
+			}
+			iterator &operator-=(const difference_type &n)
+			{
+				return *this += -n;
+			}
+			iterator operator+(const difference_type &n) const
+			{
+				iterator tmp(*this);
+				return tmp += n;
+			}
+			iterator operator-(const difference_type &n) const
+			{
+				iterator tmp(*this);
+				return tmp -= n;
+			}
+			friend iterator operator+(const difference_type &n, const iterator &it)
+			{
+				return it + n;
+			}
+			difference_type operator-(const iterator &rhs) const
+			{
+				return (node - rhs.node) * static_cast<difference_type>(block_size) + static_cast<difference_type>(off) - static_cast<difference_type>(rhs.off);
+			}
+
+			iterator &operator++()
+			{
+				if (++off == block_size)
+				{
+					++node;
+					off = 0;
+				}
+				return *this;
+			}
+			iterator operator++(int)
+			{
+				iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+			iterator &operator--()
+			{
+				if (off == 0)
+				{
+					--node;
+					off = block_size;
+				}
+				--off;
+				return *this;
+			}
+			iterator operator--(int)
+			{
+				iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			T &operator*() const
+			{
+				return (*node)[off];
+			}
+			T *operator->() const
+			{
+				return *node + off;
+			}
+			T &operator[](const difference_type &n) const
+			{
+				return *(*this + n);
+			}
+
+			bool operator==(const iterator &rhs) const
+			{
+				return node == rhs.node && off == rhs.off;
+			}
+			bool operator!=(const iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const iterator &rhs) const
+			{
+				return node < rhs.node || (node == rhs.node && off < rhs.off);
+			}
+			bool operator>(const iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		class const_iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = T;
+			using pointer = const T *;
+			using reference = const T &;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class deque;
+
+			T *const *node;
+			size_t off;
+
+		public:
+			const_iterator() : node(nullptr), off(0) {}
+			const_iterator(T *const *node_, size_t off_) : node(node_), off(off_) {}
+			const_iterator(const iterator &other) : node(other.node), off(other.off) {}
+
+			const_iterator &operator+=(const difference_type &n)
+			{
+				difference_type pos = static_cast<difference_type>(off) + n;
+				difference_type bs = static_cast<difference_type>(block_size);
+				difference_type step = pos >= 0 ? pos / bs : -((-pos - 1) / bs) - 1;
+				node += step;
+				off = static_cast<size_t>(pos - step * bs);
+				return *this;
+			}
+			const_iterator &operator-=(const difference_type &n)
+			{
+				return *this += -n;
+			}
+			const_iterator operator+(const difference_type &n) const
+			{
+				const_iterator tmp(*this);
+				return tmp += n;
+			}
+			const_iterator operator-(const difference_type &n) const
+			{
+				const_iterator tmp(*this);
+				return tmp -= n;
+			}
+			friend const_iterator operator+(const difference_type &n, const const_iterator &it)
+			{
+				return it + n;
+			}
+			difference_type operator-(const const_iterator &rhs) const
+			{
+				return (node - rhs.node) * static_cast<difference_type>(block_size) + static_cast<difference_type>(off) - static_cast<difference_type>(rhs.off);
+			}
+
+			const_iterator &operator++()
+			{
+				if (++off == block_size)
+				{
+					++node;
+					off = 0;
+				}
+				return *this;
+			}
+			const_iterator operator++(int)
+			{
+				const_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+			const_iterator &operator--()
+			{
+				if (off == 0)
+				{
+					--node;
+					off = block_size;
+				}
+				--off;
+				return *this;
+			}
+			const_iterator operator--(int)
+			{
+				const_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			const T &operator*() const
+			{
+				return (*node)[off];
+			}
+			const T *operator->() const
+			{
+				return *node + off;
+			}
+			const T &operator[](const difference_type &n) const
+			{
+				return *(*this + n);
+			}
+
+			bool operator==(const const_iterator &rhs) const
+			{
+				return node == rhs.node && off == rhs.off;
+			}
+			bool operator!=(const const_iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const const_iterator &rhs) const
+			{
+				return node < rhs.node || (node == rhs.node && off < rhs.off);
+			}
+			bool operator>(const const_iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const const_iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const const_iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		deque() : start(0), size_(0), alloc() {}
+		explicit deque(const Alloc &a) : map(ptr_alloc(a)), cache(ptr_alloc(a)), start(0), size_(0), alloc(a) {}
+		deque(const deque &other)
+			: map(ptr_alloc(alloc_traits::select_on_container_copy_construction(other.alloc))),
+			  cache(ptr_alloc(alloc_traits::select_on_container_copy_construction(other.alloc))),
+			  start(0), size_(0), alloc(alloc_traits::select_on_container_copy_construction(other.alloc))
+		{
+			try
+			{
+				for (const_iterator it = other.cbegin(); it != other.cend(); ++it)
+				{
+					push_back(*it);
+				}
+			}
+			catch (...)
+			{
+				clear();
+				free_cache();
+				throw;
+			}
+		}
+		deque(deque &&other) noexcept
+			: map(std::move(other.map)), cache(std::move(other.cache)), start(other.start), size_(other.size_), alloc(std::move(other.alloc))
+		{
+			other.start = 0;
+			other.size_ = 0;
+		}
+
+		~deque()
+		{
+			clear();
+			free_cache();
+		}
+
+		deque &operator=(const deque &other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			deque tmp(other);
+			*this = std::move(tmp);
+			return *this;
+		}
+		deque &operator=(deque &&other) noexcept(
+			alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			clear();
+			free_cache();
+			if (!alloc_traits::propagate_on_container_move_assignment::value && alloc != other.alloc)
+			{
+				// 配置器不同且不传播，不能接管对方的块，逐个移动元素
+				for (iterator it = other.begin(); it != other.end(); ++it)
+				{
+					push_back(std::move(*it));
+				}
+				other.clear();
+				return *this;
+			}
+			map = std::move(other.map);
+			cache = std::move(other.cache);
+			start = other.start;
+			size_ = other.size_;
+			if (alloc_traits::propagate_on_container_move_assignment::value)
+			{
+				alloc = std::move(other.alloc);
+			}
+			other.start = 0;
+			other.size_ = 0;
+			return *this;
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			size_t k = start + pos;
+			return map[k / block_size][k % block_size];
+		}
+		const T &at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			size_t k = start + pos;
+			return map[k / block_size][k % block_size];
+		}
+		T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		const T &front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return map[0][start];
+		}
+		const T &back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return at(size_ - 1);
+		}
+
+		iterator begin()
+		{
+			return iterator(map.data(), start);
+		}
+		const_iterator begin() const
+		{
+			return cbegin();
+		}
+		const_iterator cbegin() const
+		{
+			return const_iterator(map.data(), start);
+		}
+		iterator end()
+		{
+			return begin() + size_;
+		}
+		const_iterator end() const
+		{
+			return cend();
+		}
+		const_iterator cend() const
+		{
+			return cbegin() + size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		size_t size() const
+		{
+			return size_;
+		}
+
+		void clear()
+		{
+			destroy_all();
+		}
+
+		// 归还缓存中的空闲块
+		void shrink_to_fit()
+		{
+			free_cache();
+		}
+
+		template <class... Args>
+		T &emplace_back(Args &&...args)
+		{
+			size_t k = start + size_;
+			if (k / block_size == map.size())
+			{
+				map.push_back(acquire_block());
+			}
+			T *slot = map[k / block_size] + k % block_size;
+			try
+			{
+				new (slot) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (k % block_size == 0)
+				{
+					release_block(map[map.size() - 1]);
+					map.pop_back();
+				}
+				throw;
+			}
+			++size_;
+			return *slot;
+		}
+		template <class... Args>
+		T &emplace_front(Args &&...args)
+		{
+			bool fresh = (start == 0);
+			if (fresh)
+			{
+				map.push_front(acquire_block());
+				start = block_size;
+			}
+			try
+			{
+				new (map[0] + start - 1) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (fresh)
+				{
+					release_block(map[0]);
+					map.pop_front();
+					start = 0;
+				}
+				throw;
+			}
+			--start;
+			++size_;
+			return map[0][start];
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+		void push_front(const T &value)
+		{
+			emplace_front(value);
+		}
+		void push_front(T &&value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			--size_;
+			size_t k = start + size_;
+			(map[k / block_size] + k % block_size)->~T();
+			if (k % block_size == 0 || size_ == 0) // 末块空了
+			{
+				release_block(map[map.size() - 1]);
+				map.pop_back();
+				if (size_ == 0)
+				{
+					start = 0;
+				}
+			}
+		}
+		void pop_front()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			(map[0] + start)->~T();
+			--size_;
+			if (++start == block_size || size_ == 0) // 首块空了
+			{
+				release_block(map[0]);
+				map.pop_front();
+				start = 0;
+			}
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,573 @@
+#ifndef SJTU_DEVECTOR_HPP
+#define SJTU_DEVECTOR_HPP
+
+#include "vector.hpp"
+
+// 双端向量：一块连续缓冲区，头尾两侧都留空位，头尾插入删除均摊 O(1)，
+// 中间插入删除向较近的一端搬移；迭代器就是裸指针，data() 始终连续
+namespace sjtu
+{
+	template <typename T, class Policy = default_growth_policy, class Alloc = std::allocator<T>>
+	class devector
+	{
+	public:
+		using iterator = T *;
+		using const_iterator = const T *;
+
+	private:
+		using alloc_traits = std::allocator_traits<Alloc>;
+
+		T *buf;			  // 缓冲区
+		size_t head;	  // 首元素下标
+		size_t size_;	  // 元素个数
+		size_t capacity_; // 缓冲区容量
+		Alloc alloc;	  // 空间配置器
+
+		T *first()
+		{
+			return buf + head;
+		}
+		void destroy_all()
+		{
+			for (size_t i = 0; i < size_; ++i)
+			{
+				(buf + head + i)->~T();
+			}
+			size_ = 0;
+		}
+		void release()
+		{
+			if (buf != nullptr)
+			{
+				alloc_traits::deallocate(alloc, buf, capacity_);
+			}
+		}
+
+		// 逐个拷贝 other 的元素，要求当前为空；容量不够时用自己的配置器重新分配。
+		// 拷贝抛出时已拷贝的元素被析构，缓冲区保留
+		void copy_from(const devector &other)
+		{
+			if (capacity_ < other.size_)
+			{
+				release();
+				buf = nullptr;
+				capacity_ = 0;
+				buf = alloc_traits::allocate(alloc, other.size_);
+				capacity_ = other.size_;
+			}
+			head = 0;
+			try
+			{
+				for (; size_ < other.size_; ++size_)
+				{
+					new (buf + size_) T(other.buf[other.head + size_]);
+				}
+			}
+			catch (...)
+			{
+				destroy_all();
+				throw;
+			}
+		}
+
+		// 逐个移动 other 的元素，要求当前为空；容量不够时用自己的配置器重新分配，other 留空
+		void move_from(devector &other)
+		{
+			if (capacity_ < other.size_)
+			{
+				T *tmp = alloc_traits::allocate(alloc, other.size_);
+				release();
+				buf = tmp;
+				capacity_ = other.size_;
+			}
+			head = 0;
+			for (; size_ < other.size_; ++size_)
+			{
+				new (buf + size_) T(std::move(other.buf[other.head + size_]));
+			}
+			other.destroy_all();
+		}
+
+		// 把元素搬到容量为 new_cap 的新缓冲区，首元素放在 new_head，
+		// 并在原下标 gap 处留出一个空位（gap == size_ 表示不留）
+		void reallocate(size_t new_cap, size_t new_head, size_t gap)
+		{
+			T *tmp = alloc_traits::allocate(alloc, new_cap);
+			if (is_trivially_relocatable<T>::value)
+			{
+				if (gap != 0)
+				{
+					std::memcpy(static_cast<void *>(tmp + new_head), static_cast<const void *>(first()), gap * sizeof(T));
+				}
+				if (gap != size_)
+				{
+					std::memcpy(static_cast<void *>(tmp + new_head + gap + 1), static_cast<const void *>(first() + gap), (size_ - gap) * sizeof(T));
+				}
+			}
+			else
+			{
+				size_t i = 0;
+				try
+				{
+					for (; i < size_; ++i)
+					{
+						new (tmp + new_head + (i < gap ? i : i + 1)) T(std::move_if_noexcept(buf[head + i]));
+					}
+				}
+				catch (...)
+				{
+					for (size_t j = 0; j < i; ++j)
+					{
+						(tmp + new_head + (j < gap ? j : j + 1))->~T();
+					}
+					alloc_traits::deallocate(alloc, tmp, new_cap);
+					throw;
+				}
+				for (size_t j = 0; j < size_; ++j)
+				{
+					(buf + head + j)->~T();
+				}
+			}
+			release();
+			buf = tmp;
+			head = new_head;
+			capacity_ = new_cap;
+		}
+
+		// 一端没有空位时调用：空闲足够就原地居中，否则扩容后居中，
+		// 两侧都至少留出一个空位，并在原下标 gap 处留出一个空位
+		void make_room(size_t gap)
+		{
+			size_t new_cap = capacity_;
+			if (size_ + 1 >= capacity_ / 2)
+			{
+				new_cap = Policy::grow(capacity_);
+				if (new_cap < size_ + 3)
+				{
+					new_cap = size_ + 3;
+				}
+			}
+			size_t new_head = (new_cap - size_ - 1) / 2;
+			if (new_cap == capacity_ && !is_trivially_relocatable<T>::value)
+			{
+				recentre(new_head, gap);
+				return;
+			}
+			if (new_cap == capacity_)
+			{
+				T *old = first();
+				if (new_head > head) // 右移时先搬后半段，免得被前半段覆盖
+				{
+					std::memmove(static_cast<void *>(buf + new_head + gap + 1), static_cast<const void *>(old + gap), (size_ - gap) * sizeof(T));
+					std::memmove(static_cast<void *>(buf + new_head), static_cast<const void *>(old), gap * sizeof(T));
+				}
+				else
+				{
+					std::memmove(static_cast<void *>(buf + new_head), static_cast<const void *>(old), gap * sizeof(T));
+					std::memmove(static_cast<void *>(buf + new_head + gap + 1), static_cast<const void *>(old + gap), (size_ - gap) * sizeof(T));
+				}
+				head = new_head;
+				return;
+			}
+			reallocate(new_cap, new_head, gap);
+		}
+
+		// 容量不变时原地居中（不可平凡搬移的 T）：逐个移到新位置，目标处已有元素时移动赋值，否则移动构造。
+		// 右移时从后往前、左移时从前往后，目标总是空位或已搬走的元素；最后析构新区间之外的旧元素
+		void recentre(size_t new_head, size_t gap)
+		{
+			bool right = new_head >= head;
+			for (size_t k = 0; k < size_; ++k)
+			{
+				size_t i = right ? size_ - 1 - k : k;
+				size_t from = head + i;
+				size_t to = new_head + (i < gap ? i : i + 1);
+				if (to == from)
+				{
+					continue;
+				}
+				if (to >= head && to < head + size_)
+				{
+					buf[to] = std::move(buf[from]);
+				}
+				else
+				{
+					new (buf + to) T(std::move(buf[from]));
+				}
+			}
+			for (size_t p = head; p < head + size_; ++p)
+			{
+				if (p < new_head || p > new_head + size_ || p == new_head + gap)
+				{
+					(buf + p)->~T();
+				}
+			}
+			head = new_head;
+		}
+
+		// 把 [from, from + n) 向左移一格，空出 from + n - 1；要求左侧有空位
+		void shift_left(size_t from, size_t n)
+		{
+			if (n == 0)
+			{
+				return;
+			}
+			if (is_trivially_relocatable<T>::value)
+			{
+				std::memmove(static_cast<void *>(buf + from - 1), static_cast<const void *>(buf + from), n * sizeof(T));
+				return;
+			}
+			new (buf + from - 1) T(std::move(buf[from]));
+			for (size_t i = from; i + 1 < from + n; ++i)
+			{
+				buf[i] = std::move(buf[i + 1]);
+			}
+			(buf + from + n - 1)->~T();
+		}
+		// 把 [from, from + n) 向右移一格，空出 from；要求右侧有空位
+		void shift_right(size_t from, size_t n)
+		{
+			if (n == 0)
+			{
+				return;
+			}
+			if (is_trivially_relocatable<T>::value)
+			{
+				std::memmove(static_cast<void *>(buf + from + 1), static_cast<const void *>(buf + from), n * sizeof(T));
+				return;
+			}
+			new (buf + from + n) T(std::move(buf[from + n - 1]));
+			for (size_t i = from + n - 1; i > from; --i)
+			{
+				buf[i] = std::move(buf[i - 1]);
+			}
+			(buf + from)->~T();
+		}
+
+	public:
+		devector() : buf(nullptr), head(0), size_(0), capacity_(0), alloc() {}
+		explicit devector(const Alloc &a) : buf(nullptr), head(0), size_(0), capacity_(0), alloc(a) {}
+		devector(const devector &other)
+			: buf(nullptr), head(0), size_(0), capacity_(0),
+			  alloc(alloc_traits::select_on_container_copy_construction(other.alloc))
+		{
+			if (other.size_ == 0)
+			{
+				return;
+			}
+			buf = alloc_traits::allocate(alloc, other.size_);
+			capacity_ = other.size_;
+			try
+			{
+				for (; size_ < other.size_; ++size_)
+				{
+					new (buf + size_) T(other.buf[other.head + size_]);
+				}
+			}
+			catch (...)
+			{
+				destroy_all();
+				release();
+				throw;
+			}
+		}
+		devector(devector &&other) noexcept
+			: buf(other.buf), head(other.head), size_(other.size_), capacity_(other.capacity_), alloc(std::move(other.alloc))
+		{
+			other.buf = nullptr;
+			other.head = other.size_ = other.capacity_ = 0;
+		}
+
+		~devector()
+		{
+			destroy_all();
+			release();
+		}
+
+		devector &operator=(const devector &other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy_all();
+			if (alloc_traits::propagate_on_container_copy_assignment::value && alloc != other.alloc)
+			{
+				release(); // 旧内存须由旧配置器释放
+				buf = nullptr;
+				capacity_ = 0;
+			}
+			if (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				alloc = other.alloc;
+			}
+			copy_from(other);
+			return *this;
+		}
+		devector &operator=(devector &&other) noexcept(
+			alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy_all();
+			if (!alloc_traits::propagate_on_container_move_assignment::value && alloc != other.alloc)
+			{
+				move_from(other); // 配置器不同且不传播，不能接管对方内存
+				return *this;
+			}
+			release();
+			if (alloc_traits::propagate_on_container_move_assignment::value)
+			{
+				alloc = std::move(other.alloc);
+			}
+			buf = other.buf;
+			head = other.head;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.buf = nullptr;
+			other.head = other.size_ = other.capacity_ = 0;
+			return *this;
+		}
+
+		Alloc get_allocator() const
+		{
+			return alloc;
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return buf[head + pos];
+		}
+		const T &at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return buf[head + pos];
+		}
+		T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		const T &front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return buf[head];
+		}
+		const T &back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return buf[head + size_ - 1];
+		}
+
+		T *data()
+		{
+			return buf + head;
+		}
+		const T *data() const
+		{
+			return buf + head;
+		}
+
+		iterator begin()
+		{
+			return buf + head;
+		}
+		const_iterator begin() const
+		{
+			return buf + head;
+		}
+		const_iterator cbegin() const
+		{
+			return buf + head;
+		}
+		iterator end()
+		{
+			return buf + head + size_;
+		}
+		const_iterator end() const
+		{
+			return buf + head + size_;
+		}
+		const_iterator cend() const
+		{
+			return buf + head + size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		size_t size() const
+		{
+			return size_;
+		}
+		size_t capacity() const
+		{
+			return capacity_;
+		}
+		// 首元素之前的空位数
+		size_t front_free() const
+		{
+			return head;
+		}
+		// 末元素之后的空位数
+		size_t back_free() const
+		{
+			return capacity_ - head - size_;
+		}
+
+		void clear()
+		{
+			destroy_all();
+			head = capacity_ / 2;
+		}
+
+		template <class... Args>
+		T &emplace_back(Args &&...args)
+		{
+			if (back_free() == 0)
+			{
+				T tmp(std::forward<Args>(args)...); // 参数可能引用自身元素
+				make_room(size_);
+				new (buf + head + size_) T(std::move(tmp));
+			}
+			else
+			{
+				new (buf + head + size_) T(std::forward<Args>(args)...);
+			}
+			return buf[head + size_++];
+		}
+		template <class... Args>
+		T &emplace_front(Args &&...args)
+		{
+			if (head == 0)
+			{
+				T tmp(std::forward<Args>(args)...);
+				make_room(size_);
+				new (buf + head - 1) T(std::move(tmp));
+			}
+			else
+			{
+				new (buf + head - 1) T(std::forward<Args>(args)...);
+			}
+			--head;
+			++size_;
+			return buf[head];
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+		void push_front(const T &value)
+		{
+			emplace_front(value);
+		}
+		void push_front(T &&value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			(buf + head + size_ - 1)->~T();
+			--size_;
+		}
+		void pop_front()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			(buf + head)->~T();
+			++head;
+			--size_;
+		}
+
+		// 迭代器就是指针，写成模板以免字面量 0 与下标重载产生歧义
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		iterator insert(It pos, const T &value)
+		{
+			return insert(static_cast<size_t>(pos - begin()), value);
+		}
+		iterator insert(const size_t &ind, const T &value)
+		{
+			if (ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			T tmp(value); // value 可能引用自身元素
+			if (ind < size_ / 2 ? head == 0 : back_free() == 0)
+			{
+				make_room(ind); // 扩容时直接在 ind 处留出空位
+			}
+			else if (ind < size_ / 2)
+			{
+				shift_left(head, ind); // 前半段整体左移
+				--head;
+			}
+			else
+			{
+				shift_right(head + ind, size_ - ind); // 后半段整体右移
+			}
+			new (buf + head + ind) T(std::move(tmp));
+			++size_;
+			return begin() + ind;
+		}
+
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		iterator erase(It pos)
+		{
+			return erase(static_cast<size_t>(pos - begin()));
+		}
+		iterator erase(const size_t &ind)
+		{
+			if (ind >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			(buf + head + ind)->~T();
+			if (ind < size_ / 2)
+			{
+				shift_right(head, ind); // 前半段整体右移补位
+				++head;
+			}
+			else
+			{
+				shift_left(head + ind + 1, size_ - ind - 1); // 后半段整体左移补位
+			}
+			--size_;
+			return begin() + ind;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef SJTU_MMAP_VECTOR_HPP
+#define SJTU_MMAP_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 文件映射向量：元素直接存放在 mmap 映射的文件里，接口与 vector 一致。
+// open() 只映射已有文件，不逐个读入元素，耗时与文件大小无关；多个进程打开同一文件时共享页缓存。
+// 文件开头是一个定长文件头，记录元素大小和元素个数，之后是 capacity 个元素。
+// 元素个数在 flush()/sync()/close() 时写回文件头；只支持可平凡拷贝的 T。
+// 删除元素不缩小文件：其他进程可能仍映射着尾部，截短会让它们访问时收到 SIGBUS，只有显式 shrink_to_fit() 才截短
+namespace sjtu
+{
+	template <typename T, class Policy = default_growth_policy>
+	class mmap_vector
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "mmap_vector stores raw bytes of T");
+		static_assert(alignof(T) <= 64, "elements are placed right after a 64-byte header");
+
+	public:
+		using iterator = T *;
+		using const_iterator = const T *;
+
+	private:
+		struct header
+		{
+			unsigned long long magic;	  // 文件标识
+			unsigned long long elem_size; // sizeof(T)，打开时校验
+			unsigned long long size;	  // 元素个数
+		};
+		static const size_t header_bytes = 64;
+		static const unsigned long long file_magic = 0x52544356504d4d53ULL; // "SMMPVCTR"
+
+		int fd;			  // 文件描述符，未打开时为 -1
+		char *base;		  // 映射起点，即文件头
+		size_t bytes;	  // 映射长度
+		T *data;		  // 首元素
+		size_t size_;	  // 元素个数
+		size_t capacity_; // 文件中可容纳的元素个数
+
+		header *hdr()
+		{
+			return reinterpret_cast<header *>(base);
+		}
+		static size_t bytes_for(size_t cap)
+		{
+			return header_bytes + cap * sizeof(T);
+		}
+
+		// 把文件截短到 len 字节，要求映射不超过 len。失败时文件只是多出一段尾部，下次 open 时计入容量，
+		// 元素个数仍以文件头为准，数据不受影响，所以只返回是否成功，由调用方决定是否在意
+		bool trim_file(size_t len)
+		{
+			return ::ftruncate(fd, static_cast<off_t>(len)) == 0;
+		}
+
+		// 把文件和映射一起调整到容纳 new_cap 个元素；Linux 下用 mremap，不拷贝页面。
+		// 变大时先加长文件再映射，变小时先缩映射再截短文件，映射始终落在文件之内。
+		// 其他系统先建新映射、成功后才解除旧映射，失败时旧映射原样保留，base 不会悬空
+		void remap(size_t new_cap)
+		{
+			if (fd < 0)
+			{
+				throw runtime_error();
+			}
+			size_t new_bytes = bytes_for(new_cap);
+			if (new_bytes > bytes && ::ftruncate(fd, static_cast<off_t>(new_bytes)) != 0)
+			{
+				throw runtime_error();
+			}
+#ifdef __linux__
+			void *p = ::mremap(base, bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+			void *p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (p != MAP_FAILED)
+			{
+				::munmap(base, bytes);
+			}
+#endif
+			if (p == MAP_FAILED)
+			{
+				if (new_bytes > bytes)
+				{
+					trim_file(bytes);
+				}
+				throw runtime_error();
+			}
+			base = static_cast<char *>(p);
+			if (new_bytes < bytes)
+			{
+				trim_file(new_bytes);
+			}
+			bytes = new_bytes;
+			data = reinterpret_cast<T *>(base + header_bytes);
+			capacity_ = new_cap;
+		}
+
+		void reset()
+		{
+			fd = -1;
+			base = nullptr;
+			bytes = 0;
+			data = nullptr;
+			size_ = capacity_ = 0;
+		}
+
+	public:
+		mmap_vector()
+		{
+			reset();
+		}
+		// 打开 path，不存在时新建
+		explicit mmap_vector(const char *path)
+		{
+			reset();
+			open(path);
+		}
+		mmap_vector(const mmap_vector &) = delete;
+		mmap_vector &operator=(const mmap_vector &) = delete;
+		mmap_vector(mmap_vector &&other) noexcept
+			: fd(other.fd), base(other.base), bytes(other.bytes), data(other.data), size_(other.size_), capacity_(other.capacity_)
+		{
+			other.reset();
+		}
+		mmap_vector &operator=(mmap_vector &&other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			close();
+			fd = other.fd;
+			base = other.base;
+			bytes = other.bytes;
+			data = other.data;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.reset();
+			return *this;
+		}
+
+		~mmap_vector()
+		{
+			close();
+		}
+
+		// 映射 path 对应的文件，不存在或为空时新建；文件头不匹配时抛出 runtime_error
+		void open(const char *path)
+		{
+			close();
+			int f = ::open(path, O_RDWR | O_CREAT, 0644);
+			if (f < 0)
+			{
+				throw runtime_error();
+			}
+			struct stat st;
+			if (::fstat(f, &st) != 0)
+			{
+				::close(f);
+				throw runtime_error();
+			}
+			size_t len = static_cast<size_t>(st.st_size);
+			bool fresh = (len == 0);
+			if (fresh)
+			{
+				len = header_bytes;
+				if (::ftruncate(f, static_cast<off_t>(len)) != 0)
+				{
+					::close(f);
+					throw runtime_error();
+				}
+			}
+			if (len < header_bytes || (len - header_bytes) % sizeof(T) != 0)
+			{
+				::close(f);
+				throw runtime_error();
+			}
+			void *p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, f, 0);
+			if (p == MAP_FAILED)
+			{
+				::close(f);
+				throw runtime_error();
+			}
+			header *h = static_cast<header *>(p);
+			if (fresh)
+			{
+				h->magic = file_magic;
+				h->elem_size = sizeof(T);
+				h->size = 0;
+			}
+			size_t cap = (len - header_bytes) / sizeof(T);
+			if (h->magic != file_magic || h->elem_size != sizeof(T) || h->size > cap)
+			{
+				::munmap(p, len);
+				::close(f);
+				throw runtime_error();
+			}
+			fd = f;
+			base = static_cast<char *>(p);
+			bytes = len;
+			data = reinterpret_cast<T *>(base + header_bytes);
+			size_ = h->size;
+			capacity_ = cap;
+		}
+
+		// 写回元素个数并解除映射；未打开时什么也不做，没有映射时只关闭文件
+		void close()
+		{
+			if (fd < 0)
+			{
+				return;
+			}
+			if (base != nullptr)
+			{
+				hdr()->size = size_;
+				::munmap(base, bytes);
+			}
+			::close(fd);
+			reset();
+		}
+
+		bool is_open() const
+		{
+			return fd >= 0;
+		}
+
+		// 写回元素个数并发起异步写盘，立即返回
+		void flush()
+		{
+			if (fd < 0)
+			{
+				return;
+			}
+			hdr()->size = size_;
+			if (::msync(base, bytes, MS_ASYNC) != 0)
+			{
+				throw runtime_error();
+			}
+		}
+		// 写回元素个数并等待数据落盘
+		void sync()
+		{
+			if (fd < 0)
+			{
+				return;
+			}
+			hdr()->size = size_;
+			if (::msync(base, bytes, MS_SYNC) != 0 || ::fsync(fd) != 0)
+			{
+				throw runtime_error();
+			}
+		}
+
+		void Double()
+		{
+			remap(Policy::grow(capacity_));
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+		const T &at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+		T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		const T &front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return data[0];
+		}
+		const T &back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return data[size_ - 1];
+		}
+
+		iterator begin()
+		{
+			return data;
+		}
+		const_iterator begin() const
+		{
+			return data;
+		}
+		const_iterator cbegin() const
+		{
+			return data;
+		}
+		iterator end()
+		{
+			return data + size_;
+		}
+		const_iterator end() const
+		{
+			return data + size_;
+		}
+		const_iterator cend() const
+		{
+			return data + size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		size_t size() const
+		{
+			return size_;
+		}
+		size_t capacity() const
+		{
+			return capacity_;
+		}
+
+		void reserve(size_t n)
+		{
+			if (n > capacity_)
+			{
+				remap(n);
+			}
+		}
+		void shrink_to_fit()
+		{
+			if (capacity_ > size_)
+			{
+				remap(size_);
+			}
+		}
+		void clear()
+		{
+			size_ = 0;
+		}
+
+		// 迭代器就是指针，写成模板以免字面量 0 与下标重载产生歧义
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		iterator insert(It pos, const T &value)
+		{
+			return insert(static_cast<size_t>(pos - begin()), value);
+		}
+		iterator insert(const size_t &ind, const T &value)
+		{
+			if (ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			T tmp(value); // value 可能引用自身元素，扩容后失效
+			if (size_ == capacity_)
+			{
+				Double();
+			}
+			std::memmove(static_cast<void *>(data + ind + 1), static_cast<const void *>(data + ind), (size_ - ind) * sizeof(T));
+			std::memcpy(static_cast<void *>(data + ind), static_cast<const void *>(&tmp), sizeof(T));
+			++size_;
+			return begin() + ind;
+		}
+
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		iterator erase(It pos)
+		{
+			return erase(static_cast<size_t>(pos - begin()));
+		}
+		iterator erase(const size_t &ind)
+		{
+			if (ind >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			std::memmove(static_cast<void *>(data + ind), static_cast<const void *>(data + ind + 1), (size_ - ind - 1) * sizeof(T));
+			--size_;
+			return begin() + ind;
+		}
+
+		template <class... Args>
+		T &emplace_back(Args &&...args)
+		{
+			T tmp(std::forward<Args>(args)...);
+			if (size_ == capacity_)
+			{
+				Double();
+			}
+			std::memcpy(static_cast<void *>(data + size_), static_cast<const void *>(&tmp), sizeof(T));
+			return data[size_++];
+		}
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			--size_;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include "vector.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// 并行算法：把 vector 的下标区间按 grain 切块，交给可复用的线程池执行，调用线程也参与计算。
+// 分块只取决于元素个数和 grain，与线程数无关；deterministic 为 true 时归约按块的顺序合并，
+// 结果与线程数和调度无关，否则各块结果按完成的先后合并，浮点结果可能随调度变化。
+// 输出向量先调整到目标大小再由各块赋值，所以其元素类型须可默认构造、可拷贝赋值
+namespace sjtu
+{
+	// 固定线程数的线程池，run() 阻塞到全部任务完成；同一时刻只执行一批任务，不可在任务中嵌套调用
+	class thread_pool
+	{
+	private:
+		vector<std::thread> workers;
+		std::mutex m;
+		std::mutex run_lock;			   // 串行化并发的 run()
+		std::condition_variable work_cv;   // 通知工作线程有新一批任务
+		std::condition_variable done_cv;   // 通知调用线程本批任务结束
+		std::function<void(size_t)> job;   // 当前这批任务
+		size_t tasks;					   // 任务个数
+		std::atomic<size_t> next;		   // 下一个待领取的任务
+		size_t pending;					   // 尚未结束本批任务的工作线程数
+		size_t generation;				   // 批次编号
+		bool stop;
+		std::exception_ptr error;		   // 第一个抛出的异常
+
+		void drain()
+		{
+			size_t i;
+			while ((i = next.fetch_add(1)) < tasks)
+			{
+				try
+				{
+					job(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(m);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+					next.store(tasks); // 不再领取新任务
+				}
+			}
+		}
+
+		void worker_loop()
+		{
+			size_t seen = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(m);
+					work_cv.wait(lock, [&] { return stop || generation != seen; });
+					if (stop)
+					{
+						return;
+					}
+					seen = generation;
+				}
+				drain();
+				std::lock_guard<std::mutex> lock(m);
+				if (--pending == 0)
+				{
+					done_cv.notify_one();
+				}
+			}
+		}
+
+	public:
+		// threads 为参与计算的线程总数（含调用线程），0 表示取硬件线程数
+		explicit thread_pool(size_t threads = 0)
+			: tasks(0), next(0), pending(0), generation(0), stop(false)
+		{
+			if (threads == 0)
+			{
+				threads = std::thread::hardware_concurrency();
+			}
+			for (size_t i = 1; i < threads; ++i)
+			{
+				workers.push_back(std::thread([this] { worker_loop(); }));
+			}
+		}
+		thread_pool(const thread_pool &) = delete;
+		thread_pool &operator=(const thread_pool &) = delete;
+
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m);
+				stop = true;
+			}
+			work_cv.notify_all();
+			for (size_t i = 0; i < workers.size(); ++i)
+			{
+				workers[i].join();
+			}
+		}
+
+		size_t size() const
+		{
+			return workers.size() + 1;
+		}
+
+		// 对 i = 0 .. n - 1 各调用一次 f(i)，任务抛出的第一个异常在此重新抛出
+		template <class F>
+		void run(size_t n, F &&f)
+		{
+			if (n == 0)
+			{
+				return;
+			}
+			std::lock_guard<std::mutex> guard(run_lock);
+			if (workers.empty() || n == 1)
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					f(i);
+				}
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> lock(m);
+				job = std::ref(f);
+				tasks = n;
+				next.store(0);
+				pending = workers.size();
+				error = nullptr;
+				++generation;
+			}
+			work_cv.notify_all();
+			drain();
+			std::unique_lock<std::mutex> lock(m);
+			done_cv.wait(lock, [&] { return pending == 0; });
+			job = nullptr;
+			if (error)
+			{
+				std::exception_ptr e = error;
+				error = nullptr;
+				std::rethrow_exception(e);
+			}
+		}
+	};
+
+	namespace parallel
+	{
+		// 进程内共享的默认线程池，首次使用时创建
+		inline thread_pool &default_pool()
+		{
+			static thread_pool pool;
+			return pool;
+		}
+
+		struct options
+		{
+			size_t grain = 0;			// 每块元素个数，0 表示按线程数自动选取
+			bool deterministic = false; // 归约是否按块顺序合并
+			thread_pool *pool = nullptr; // 为空时使用 default_pool()
+		};
+
+		namespace detail
+		{
+			inline thread_pool &pool_of(const options &opt)
+			{
+				return opt.pool != nullptr ? *opt.pool : default_pool();
+			}
+			// 每个线程约分到 8 块以均衡负载，但每块不少于 4096 个元素
+			inline size_t grain_of(const options &opt, size_t n)
+			{
+				if (opt.grain != 0)
+				{
+					return opt.grain;
+				}
+				size_t g = n / (pool_of(opt).size() * 8);
+				return g < 4096 ? 4096 : g;
+			}
+			inline size_t blocks_of(size_t n, size_t grain)
+			{
+				return (n + grain - 1) / grain;
+			}
+
+			template <class V>
+			auto data_of(V &v) -> decltype(&v[0])
+			{
+				return v.empty() ? nullptr : &v[0];
+			}
+
+			// 把 [0, n) 按 grain 切块并行执行 f(begin, end, block)
+			template <class F>
+			void for_blocks(size_t n, const options &opt, F &&f)
+			{
+				size_t grain = grain_of(opt, n);
+				size_t blocks = blocks_of(n, grain);
+				pool_of(opt).run(blocks, [&](size_t b) {
+					size_t l = b * grain;
+					f(l, l + grain < n ? l + grain : n, b);
+				});
+			}
+
+			// 使 out 恰有 n 个元素，之后由各块并行赋值；因此输出向量的元素须可默认构造、可拷贝赋值
+			template <class T, class Policy, size_t N, class Alloc>
+			void prepare(vector<T, Policy, N, Alloc> &out, size_t n)
+			{
+				static_assert(std::is_default_constructible<T>::value && std::is_copy_assignable<T>::value,
+							  "parallel outputs are filled by assignment into default-constructed elements");
+				if (out.size() != n)
+				{
+					out.clear();
+					out.insert(0, n, T());
+				}
+			}
+		}
+
+		template <class T, class Policy, size_t N, class Alloc, class F>
+		void for_each(vector<T, Policy, N, Alloc> &v, F f, const options &opt = options())
+		{
+			T *p = detail::data_of(v);
+			detail::for_blocks(v.size(), opt, [&](size_t l, size_t r, size_t) {
+				for (size_t i = l; i < r; ++i)
+				{
+					f(p[i]);
+				}
+			});
+		}
+
+		// out[i] = f(in[i])；out 的元素个数调整为与 in 相同，out 可以就是 in
+		template <class T, class P1, size_t N1, class A1, class U, class P2, size_t N2, class A2, class F>
+		void transform(const vector<T, P1, N1, A1> &in, vector<U, P2, N2, A2> &out, F f, const options &opt = options())
+		{
+			detail::prepare(out, in.size());
+			const T *src = detail::data_of(in);
+			U *dst = detail::data_of(out);
+			detail::for_blocks(in.size(), opt, [&](size_t l, size_t r, size_t) {
+				for (size_t i = l; i < r; ++i)
+				{
+					dst[i] = f(src[i]);
+				}
+			});
+		}
+
+		// 以 init 为初值按 op 归约，op 须满足结合律
+		template <class T, class Policy, size_t N, class Alloc, class Op = std::plus<T>>
+		T reduce(const vector<T, Policy, N, Alloc> &v, T init, Op op = Op(), const options &opt = options())
+		{
+			size_t n = v.size();
+			if (n == 0)
+			{
+				return init;
+			}
+			const T *p = detail::data_of(v);
+			size_t grain = detail::grain_of(opt, n);
+			size_t blocks = detail::blocks_of(n, grain);
+			options o = opt;
+			o.grain = grain;
+			if (opt.deterministic)
+			{
+				vector<T> partial;
+				detail::prepare(partial, blocks);
+				detail::for_blocks(n, o, [&](size_t l, size_t r, size_t b) {
+					T acc = p[l];
+					for (size_t i = l + 1; i < r; ++i)
+					{
+						acc = op(acc, p[i]);
+					}
+					partial[b] = acc;
+				});
+				for (size_t b = 0; b < blocks; ++b)
+				{
+					init = op(init, partial[b]);
+				}
+				return init;
+			}
+			std::mutex lock;
+			detail::for_blocks(n, o, [&](size_t l, size_t r, size_t) {
+				T acc = p[l];
+				for (size_t i = l + 1; i < r; ++i)
+				{
+					acc = op(acc, p[i]);
+				}
+				std::lock_guard<std::mutex> guard(lock);
+				init = op(init, acc);
+			});
+			return init;
+		}
+
+		template <class T, class Policy, size_t N, class Alloc, class Pred>
+		size_t count_if(const vector<T, Policy, N, Alloc> &v, Pred pred, const options &opt = options())
+		{
+			const T *p = detail::data_of(v);
+			std::atomic<size_t> total(0);
+			detail::for_blocks(v.size(), opt, [&](size_t l, size_t r, size_t) {
+				size_t c = 0;
+				for (size_t i = l; i < r; ++i)
+				{
+					c += pred(p[i]) ? 1 : 0;
+				}
+				total.fetch_add(c);
+			});
+			return total.load();
+		}
+
+		// out[i] = in[0] op in[1] op ... op in[i]；先并行求各块之和，再串行求块前缀，最后并行回填，
+		// 合并顺序固定，结果总是确定的。每个位置都先读后写，out 可以就是 in
+		template <class T, class P1, size_t N1, class A1, class P2, size_t N2, class A2, class Op = std::plus<T>>
+		void inclusive_scan(const vector<T, P1, N1, A1> &in, vector<T, P2, N2, A2> &out, Op op = Op(), const options &opt = options())
+		{
+			size_t n = in.size();
+			detail::prepare(out, n);
+			if (n == 0)
+			{
+				return;
+			}
+			const T *src = detail::data_of(in);
+			T *dst = detail::data_of(out);
+			options o = opt;
+			o.grain = detail::grain_of(opt, n);
+			size_t blocks = detail::blocks_of(n, o.grain);
+			vector<T> carry; // carry[b] 为前 b + 1 块之和
+			detail::prepare(carry, blocks);
+			detail::for_blocks(n, o, [&](size_t l, size_t r, size_t b) {
+				T acc = src[l];
+				for (size_t i = l + 1; i < r; ++i)
+				{
+					acc = op(acc, src[i]);
+				}
+				carry[b] = acc;
+			});
+			for (size_t b = 1; b < blocks; ++b)
+			{
+				carry[b] = op(carry[b - 1], carry[b]);
+			}
+			detail::for_blocks(n, o, [&](size_t l, size_t r, size_t b) {
+				T acc = b == 0 ? src[l] : op(carry[b - 1], src[l]);
+				dst[l] = acc;
+				for (size_t i = l + 1; i < r; ++i)
+				{
+					acc = op(acc, src[i]);
+					dst[i] = acc;
+				}
+			});
+		}
+
+		// 按原顺序把满足 pred 的元素复制到 out：先并行计数，再按块前缀确定写入位置。
+		// out 与 in 是同一个 vector 时先写到临时 vector 再换回，否则调整 out 的大小会释放正在读的元素
+		template <class T, class P1, size_t N1, class A1, class P2, size_t N2, class A2, class Pred>
+		void copy_if(const vector<T, P1, N1, A1> &in, vector<T, P2, N2, A2> &out, Pred pred, const options &opt = options())
+		{
+			if (static_cast<const void *>(&in) == static_cast<const void *>(&out))
+			{
+				vector<T, P2, N2, A2> tmp(out.get_allocator());
+				parallel::copy_if(in, tmp, pred, opt);
+				out = std::move(tmp);
+				return;
+			}
+			size_t n = in.size();
+			const T *src = detail::data_of(in);
+			options o = opt;
+			o.grain = detail::grain_of(opt, n);
+			size_t blocks = detail::blocks_of(n, o.grain);
+			vector<size_t> offset; // offset[b] 为第 b 块之前命中的元素个数
+			detail::prepare(offset, blocks + 1);
+			detail::for_blocks(n, o, [&](size_t l, size_t r, size_t b) {
+				size_t c = 0;
+				for (size_t i = l; i < r; ++i)
+				{
+					c += pred(src[i]) ? 1 : 0;
+				}
+				offset[b + 1] = c;
+			});
+			for (size_t b = 1; b <= blocks; ++b)
+			{
+				offset[b] += offset[b - 1];
+			}
+			detail::prepare(out, offset[blocks]);
+			T *dst = detail::data_of(out);
+			detail::for_blocks(n, o, [&](size_t l, size_t r, size_t b) {
+				size_t k = offset[b];
+				for (size_t i = l; i < r; ++i)
+				{
+					if (pred(src[i]))
+					{
+						dst[k++] = src[i];
+					}
+				}
+			});
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef SJTU_SERIALIZE_HPP
+#define SJTU_SERIALIZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include "exceptions.hpp"
+
+// 容器二进制存档：文件头之后是元素流。
+// 文件头依次为 "SJTU"、格式版本、容器种类、是否整块存储、元素字节数、元素个数，整数均按本机字节序。
+// 每种元素的读写由 serializer<T> 决定：可平凡拷贝的类型按原始字节读写（bitwise 为 true，
+// 连续存放的容器可整块 memcpy）；其他类型需自行特化 serializer，提供 bitwise = false、write、read，
+// 且每个元素至少写出 1 字节（读档时据此校验个数）
+namespace sjtu
+{
+	template <typename T, class Enable = void>
+	struct serializer;
+
+	template <typename T>
+	struct serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+	{
+		static const bool bitwise = true;
+
+		static void write(std::ostream &os, const T &value)
+		{
+			os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+		}
+		static T read(std::istream &is)
+		{
+			T value;
+			if (!is.read(reinterpret_cast<char *>(&value), sizeof(T)))
+			{
+				throw runtime_error();
+			}
+			return value;
+		}
+	};
+
+	// 存档里的个数或长度不可信，不能照着一次分配。流可定位时，检查剩余字节够不够 n 个
+	// 每个至少 min_bytes 字节的元素，不够就抛出 runtime_error，够则返回 n；
+	// 流不可定位（管道等）时只返回一个有限的初始容量，调用方须边读边增长
+	inline size_t archive_reserve(std::istream &is, std::uint64_t n, size_t min_bytes)
+	{
+		const size_t initial = 1024;
+		if (n > static_cast<std::uint64_t>(static_cast<size_t>(-1)))
+		{
+			throw runtime_error();
+		}
+		std::streambuf *sb = is.rdbuf();
+		std::streampos cur = sb == nullptr ? std::streampos(-1) : sb->pubseekoff(0, std::ios::cur, std::ios::in);
+		if (cur == std::streampos(-1))
+		{
+			return n < initial ? static_cast<size_t>(n) : initial;
+		}
+		std::streampos end = sb->pubseekoff(0, std::ios::end, std::ios::in);
+		sb->pubseekpos(cur, std::ios::in);
+		if (end == std::streampos(-1))
+		{
+			return n < initial ? static_cast<size_t>(n) : initial;
+		}
+		std::uint64_t left = end < cur ? 0 : static_cast<std::uint64_t>(end - cur);
+		if (min_bytes != 0 && n > left / min_bytes)
+		{
+			throw runtime_error();
+		}
+		return static_cast<size_t>(n);
+	}
+
+	// 字符串：长度加内容
+	template <>
+	struct serializer<std::string>
+	{
+		static const bool bitwise = false;
+
+		static void write(std::ostream &os, const std::string &value)
+		{
+			serializer<std::uint64_t>::write(os, value.size());
+			os.write(value.data(), value.size());
+		}
+		// 长度来自存档，不可信：按块读入，读多少长多少
+		static std::string read(std::istream &is)
+		{
+			std::uint64_t n = serializer<std::uint64_t>::read(is);
+			std::string value;
+			value.reserve(archive_reserve(is, n, 1));
+			char buf[4096];
+			while (value.size() < n)
+			{
+				size_t k = n - value.size() < sizeof(buf) ? static_cast<size_t>(n - value.size()) : sizeof(buf);
+				if (!is.read(buf, k))
+				{
+					throw runtime_error();
+				}
+				value.append(buf, k);
+			}
+			return value;
+		}
+	};
+
+	const std::uint32_t archive_version = 1;
+
+	// 写文件头；bitwise 存档的元素字节数参与校验，逐个存储时记为 0
+	inline void write_archive_header(std::ostream &os, char kind, bool bitwise, size_t elem_size, size_t count)
+	{
+		os.write("SJTU", 4);
+		serializer<std::uint32_t>::write(os, archive_version);
+		serializer<char>::write(os, kind);
+		serializer<char>::write(os, bitwise ? 1 : 0);
+		serializer<std::uint32_t>::write(os, bitwise ? static_cast<std::uint32_t>(elem_size) : 0);
+		serializer<std::uint64_t>::write(os, count);
+	}
+
+	// 读并校验文件头，返回元素个数；格式、版本或元素布局不符时抛出 runtime_error
+	inline size_t read_archive_header(std::istream &is, char kind, bool bitwise, size_t elem_size)
+	{
+		char magic[4];
+		if (!is.read(magic, 4) || magic[0] != 'S' || magic[1] != 'J' || magic[2] != 'T' || magic[3] != 'U')
+		{
+			throw runtime_error();
+		}
+		if (serializer<std::uint32_t>::read(is) != archive_version || serializer<char>::read(is) != kind ||
+			serializer<char>::read(is) != (bitwise ? 1 : 0) ||
+			serializer<std::uint32_t>::read(is) != (bitwise ? elem_size : 0))
+		{
+			throw runtime_error();
+		}
+		std::uint64_t n = serializer<std::uint64_t>::read(is);
+		if (n > static_cast<std::uint64_t>(static_cast<size_t>(-1)))
+		{
+			throw runtime_error();
+		}
+		return static_cast<size_t>(n);
+	}
+
+	// 整块读写 n 个元素，要求元素可平凡拷贝
+	template <typename T>
+	void write_block(std::ostream &os, const T *p, size_t n)
+	{
+		os.write(reinterpret_cast<const char *>(p), n * sizeof(T));
+	}
+	template <typename T>
+	void read_block(std::istream &is, T *p, size_t n)
+	{
+		if (!is.read(reinterpret_cast<char *>(p), n * sizeof(T)))
+		{
+			throw runtime_error();
+		}
+	}
+
+}
+
+#endif
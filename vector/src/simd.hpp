@@ -0,0 +1,617 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include "vector.hpp"
+#include "utility.hpp"
+
+// 算术类型 vector 的向量化归约与查找：sum、minmax、find、count、dot。
+// 通用内核用 64 字节宽的独立累加器写成，编译器可直接生成 SIMD 代码；x86 上另有一套 AVX2 版本，
+// 其中 4、8 字节整数的 sum、count、find 用 intrinsics 手写，运行时按 CPU 支持情况选用，
+// 其余情况用默认指令集（x86-64 上即 SSE2）。浮点的累加顺序只由通用内核决定，结果在不同机器上一致
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SJTU_SIMD_DISPATCH 1
+#define SJTU_TARGET_AVX2 __attribute__((target("avx2")))
+#define SJTU_ALWAYS_INLINE __attribute__((always_inline)) inline
+#include <immintrin.h>
+#else
+#define SJTU_ALWAYS_INLINE inline
+#endif
+
+namespace sjtu
+{
+	namespace simd
+	{
+		// 求和与点积的结果类型：有符号整数累加到 long long，无符号整数累加到 unsigned long long
+		// （超出范围时按模回绕，不会有符号溢出），浮点保持原类型
+		template <class T>
+		struct accum
+		{
+			using type = typename std::conditional<
+				std::is_integral<T>::value,
+				typename std::conditional<std::is_unsigned<T>::value, unsigned long long, long long>::type,
+				T>::type;
+		};
+
+		namespace detail
+		{
+			template <class T>
+			struct lanes
+			{
+				static const size_t value = 64 / sizeof(T);
+			};
+			// 每通道的命中计数器：元素不超过 4 字节时取 32 位（char、short 也是 32 位，由 count_kernel
+			// 分段汇总防止溢出），8 字节元素取 64 位，与元素同宽以便逐通道累加
+			template <class T>
+			struct counter
+			{
+				using type = typename std::conditional<sizeof(T) <= 4, unsigned int, unsigned long long>::type;
+			};
+
+			template <class T>
+			SJTU_ALWAYS_INLINE typename accum<T>::type sum_kernel(const T *p, size_t n)
+			{
+				using A = typename accum<T>::type;
+				const size_t L = lanes<T>::value;
+				A acc[L] = {};
+				size_t i = 0;
+				for (; i + L <= n; i += L)
+				{
+					for (size_t j = 0; j < L; ++j)
+					{
+						acc[j] += p[i + j];
+					}
+				}
+				A s = 0;
+				for (size_t j = 0; j < L; ++j)
+				{
+					s += acc[j];
+				}
+				for (; i < n; ++i)
+				{
+					s += p[i];
+				}
+				return s;
+			}
+
+			// 要求 n > 0
+			template <class T>
+			SJTU_ALWAYS_INLINE void minmax_kernel(const T *p, size_t n, T &lo_out, T &hi_out)
+			{
+				const size_t L = lanes<T>::value;
+				T lo[L];
+				T hi[L];
+				for (size_t j = 0; j < L; ++j)
+				{
+					lo[j] = hi[j] = p[0];
+				}
+				size_t i = 0;
+				for (; i + L <= n; i += L)
+				{
+					for (size_t j = 0; j < L; ++j)
+					{
+						lo[j] = p[i + j] < lo[j] ? p[i + j] : lo[j];
+						hi[j] = hi[j] < p[i + j] ? p[i + j] : hi[j];
+					}
+				}
+				for (; i < n; ++i)
+				{
+					lo[0] = p[i] < lo[0] ? p[i] : lo[0];
+					hi[0] = hi[0] < p[i] ? p[i] : hi[0];
+				}
+				lo_out = lo[0];
+				hi_out = hi[0];
+				for (size_t j = 1; j < L; ++j)
+				{
+					lo_out = lo[j] < lo_out ? lo[j] : lo_out;
+					hi_out = hi_out < hi[j] ? hi[j] : hi_out;
+				}
+			}
+
+			// 整块比较，块内有命中再逐个确定位置；找不到返回 n
+			template <class T>
+			SJTU_ALWAYS_INLINE size_t find_kernel(const T *p, size_t n, T value)
+			{
+				using C = typename counter<T>::type;
+				const size_t L = lanes<T>::value;
+				size_t i = 0;
+				for (; i + L <= n; i += L)
+				{
+					C any = 0;
+					for (size_t j = 0; j < L; ++j)
+					{
+						any |= static_cast<C>(p[i + j] == value);
+					}
+					if (any != 0)
+					{
+						break;
+					}
+				}
+				for (; i < n; ++i)
+				{
+					if (p[i] == value)
+					{
+						return i;
+					}
+				}
+				return n;
+			}
+
+			template <class T>
+			SJTU_ALWAYS_INLINE size_t count_kernel(const T *p, size_t n, T value)
+			{
+				using C = typename counter<T>::type;
+				const size_t L = lanes<T>::value;
+				size_t total = 0;
+				size_t i = 0;
+				while (i + L <= n)
+				{
+					C c[L] = {};
+					size_t stop = n - (n - i) % L;
+					if (stop - i > L * 65536) // 分段汇总，32 位计数器不会溢出
+					{
+						stop = i + L * 65536;
+					}
+					for (; i < stop; i += L)
+					{
+						for (size_t j = 0; j < L; ++j)
+						{
+							c[j] += static_cast<C>(p[i + j] == value);
+						}
+					}
+					for (size_t j = 0; j < L; ++j)
+					{
+						total += c[j];
+					}
+				}
+				for (; i < n; ++i)
+				{
+					total += (p[i] == value);
+				}
+				return total;
+			}
+
+			template <class T>
+			SJTU_ALWAYS_INLINE typename accum<T>::type dot_kernel(const T *a, const T *b, size_t n)
+			{
+				using A = typename accum<T>::type;
+				const size_t L = lanes<T>::value;
+				A acc[L] = {};
+				size_t i = 0;
+				for (; i + L <= n; i += L)
+				{
+					for (size_t j = 0; j < L; ++j)
+					{
+						acc[j] += static_cast<A>(a[i + j]) * static_cast<A>(b[i + j]);
+					}
+				}
+				A s = 0;
+				for (size_t j = 0; j < L; ++j)
+				{
+					s += acc[j];
+				}
+				for (; i < n; ++i)
+				{
+					s += static_cast<A>(a[i]) * static_cast<A>(b[i]);
+				}
+				return s;
+			}
+
+#ifdef SJTU_SIMD_DISPATCH
+			inline bool has_avx2()
+			{
+				static const bool ok = __builtin_cpu_supports("avx2");
+				return ok;
+			}
+
+			// 4 字节和 8 字节整数的 sum、count、find 用 AVX2 指令手写，相等比较只看位模式，
+			// 有无符号共用一份；其余类型（浮点、char、short）沿用上面的通用内核。
+			// 选择依据 int_width<T>：4、8 为整数字节宽，0 表示走通用内核
+			template <class T>
+			struct int_width
+			{
+				static const int value = std::is_integral<T>::value && !std::is_same<T, bool>::value && (sizeof(T) == 4 || sizeof(T) == 8) ? int(sizeof(T)) : 0;
+			};
+			using generic_tag = std::integral_constant<int, 0>;
+			using i32_tag = std::integral_constant<int, 4>;
+			using i64_tag = std::integral_constant<int, 8>;
+
+			SJTU_TARGET_AVX2 inline unsigned long long hsum_epi64(__m256i v)
+			{
+				alignas(32) unsigned long long lane[4];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lane), v);
+				return lane[0] + lane[1] + lane[2] + lane[3];
+			}
+			SJTU_TARGET_AVX2 inline __m256i loadu(const void *p)
+			{
+				return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+			}
+
+			// 32 位整数逐个扩展到 64 位再累加，Signed 决定符号扩展还是零扩展；结果按模 2^64
+			template <bool Signed>
+			SJTU_TARGET_AVX2 unsigned long long sum_i32_avx2(const unsigned int *p, size_t n)
+			{
+				__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+				size_t i = 0;
+				for (; i + 16 <= n; i += 16)
+				{
+					__m256i x = loadu(p + i);
+					__m256i y = loadu(p + i + 8);
+					if (Signed)
+					{
+						a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+						a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+						a2 = _mm256_add_epi64(a2, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(y)));
+						a3 = _mm256_add_epi64(a3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(y, 1)));
+					}
+					else
+					{
+						a0 = _mm256_add_epi64(a0, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(x)));
+						a1 = _mm256_add_epi64(a1, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(x, 1)));
+						a2 = _mm256_add_epi64(a2, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(y)));
+						a3 = _mm256_add_epi64(a3, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(y, 1)));
+					}
+				}
+				unsigned long long s = hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(a0, a1), _mm256_add_epi64(a2, a3)));
+				for (; i < n; ++i)
+				{
+					s += Signed ? static_cast<unsigned long long>(static_cast<long long>(static_cast<int>(p[i]))) : p[i];
+				}
+				return s;
+			}
+			SJTU_TARGET_AVX2 inline unsigned long long sum_i64_avx2(const unsigned long long *p, size_t n)
+			{
+				__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+				size_t i = 0;
+				for (; i + 16 <= n; i += 16)
+				{
+					a0 = _mm256_add_epi64(a0, loadu(p + i));
+					a1 = _mm256_add_epi64(a1, loadu(p + i + 4));
+					a2 = _mm256_add_epi64(a2, loadu(p + i + 8));
+					a3 = _mm256_add_epi64(a3, loadu(p + i + 12));
+				}
+				unsigned long long s = hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(a0, a1), _mm256_add_epi64(a2, a3)));
+				for (; i < n; ++i)
+				{
+					s += p[i];
+				}
+				return s;
+			}
+
+			// 比较结果每个命中通道为全 1，即 -1，从计数器中减去就是加一；每段最多 2^24 轮后汇总，32 位通道不会溢出
+			SJTU_TARGET_AVX2 inline size_t count_i32_avx2(const unsigned int *p, size_t n, unsigned int value)
+			{
+				const __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+				size_t total = 0;
+				size_t i = 0;
+				while (i + 32 <= n)
+				{
+					__m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0;
+					size_t stop = i + ((n - i) / 32 < (size_t(1) << 24) ? (n - i) / 32 : (size_t(1) << 24)) * 32;
+					for (; i < stop; i += 32)
+					{
+						c0 = _mm256_sub_epi32(c0, _mm256_cmpeq_epi32(loadu(p + i), v));
+						c1 = _mm256_sub_epi32(c1, _mm256_cmpeq_epi32(loadu(p + i + 8), v));
+						c2 = _mm256_sub_epi32(c2, _mm256_cmpeq_epi32(loadu(p + i + 16), v));
+						c3 = _mm256_sub_epi32(c3, _mm256_cmpeq_epi32(loadu(p + i + 24), v));
+					}
+					__m256i c = _mm256_add_epi32(_mm256_add_epi32(c0, c1), _mm256_add_epi32(c2, c3));
+					total += hsum_epi64(_mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(c)),
+														 _mm256_cvtepu32_epi64(_mm256_extracti128_si256(c, 1))));
+				}
+				for (; i < n; ++i)
+				{
+					total += (p[i] == value);
+				}
+				return total;
+			}
+			SJTU_TARGET_AVX2 inline size_t count_i64_avx2(const unsigned long long *p, size_t n, unsigned long long value)
+			{
+				const __m256i v = _mm256_set1_epi64x(static_cast<long long>(value));
+				__m256i c0 = _mm256_setzero_si256(), c1 = c0, c2 = c0, c3 = c0;
+				size_t i = 0;
+				for (; i + 16 <= n; i += 16)
+				{
+					c0 = _mm256_sub_epi64(c0, _mm256_cmpeq_epi64(loadu(p + i), v));
+					c1 = _mm256_sub_epi64(c1, _mm256_cmpeq_epi64(loadu(p + i + 4), v));
+					c2 = _mm256_sub_epi64(c2, _mm256_cmpeq_epi64(loadu(p + i + 8), v));
+					c3 = _mm256_sub_epi64(c3, _mm256_cmpeq_epi64(loadu(p + i + 12), v));
+				}
+				size_t total = hsum_epi64(_mm256_add_epi64(_mm256_add_epi64(c0, c1), _mm256_add_epi64(c2, c3)));
+				for (; i < n; ++i)
+				{
+					total += (p[i] == value);
+				}
+				return total;
+			}
+
+			// 每轮比较 128 字节，有命中时用掩码的最低位定位
+			SJTU_TARGET_AVX2 inline size_t find_i32_avx2(const unsigned int *p, size_t n, unsigned int value)
+			{
+				const __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+				size_t i = 0;
+				for (; i + 32 <= n; i += 32)
+				{
+					__m256i e0 = _mm256_cmpeq_epi32(loadu(p + i), v);
+					__m256i e1 = _mm256_cmpeq_epi32(loadu(p + i + 8), v);
+					__m256i e2 = _mm256_cmpeq_epi32(loadu(p + i + 16), v);
+					__m256i e3 = _mm256_cmpeq_epi32(loadu(p + i + 24), v);
+					__m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+					if (!_mm256_testz_si256(any, any))
+					{
+						unsigned long long m = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(e0))) |
+											   static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(e1))) << 8 |
+											   static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(e2))) << 16 |
+											   static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(e3))) << 24;
+						return i + __builtin_ctzll(m);
+					}
+				}
+				for (; i < n; ++i)
+				{
+					if (p[i] == value)
+					{
+						return i;
+					}
+				}
+				return n;
+			}
+			SJTU_TARGET_AVX2 inline size_t find_i64_avx2(const unsigned long long *p, size_t n, unsigned long long value)
+			{
+				const __m256i v = _mm256_set1_epi64x(static_cast<long long>(value));
+				size_t i = 0;
+				for (; i + 16 <= n; i += 16)
+				{
+					__m256i e0 = _mm256_cmpeq_epi64(loadu(p + i), v);
+					__m256i e1 = _mm256_cmpeq_epi64(loadu(p + i + 4), v);
+					__m256i e2 = _mm256_cmpeq_epi64(loadu(p + i + 8), v);
+					__m256i e3 = _mm256_cmpeq_epi64(loadu(p + i + 12), v);
+					__m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+					if (!_mm256_testz_si256(any, any))
+					{
+						unsigned int m = static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(e0))) |
+										 static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(e1))) << 4 |
+										 static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(e2))) << 8 |
+										 static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(e3))) << 12;
+						return i + __builtin_ctz(m);
+					}
+				}
+				for (; i < n; ++i)
+				{
+					if (p[i] == value)
+					{
+						return i;
+					}
+				}
+				return n;
+			}
+
+			// AVX2 没有 64 位整数的 min/max，用有符号比较加 blend 代替；无符号先翻转最高位再按有符号比较。要求 n > 0
+			template <bool Signed>
+			SJTU_TARGET_AVX2 void minmax_i64_avx2(const unsigned long long *p, size_t n, unsigned long long &lo_out, unsigned long long &hi_out)
+			{
+				const unsigned long long flip = Signed ? 0 : 1ULL << 63;
+				const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(flip));
+				__m256i lo0 = _mm256_set1_epi64x(static_cast<long long>(p[0] ^ flip)), lo1 = lo0, hi0 = lo0, hi1 = lo0;
+				size_t i = 0;
+				for (; i + 8 <= n; i += 8)
+				{
+					__m256i x = _mm256_xor_si256(loadu(p + i), bias);
+					__m256i y = _mm256_xor_si256(loadu(p + i + 4), bias);
+					lo0 = _mm256_blendv_epi8(lo0, x, _mm256_cmpgt_epi64(lo0, x));
+					lo1 = _mm256_blendv_epi8(lo1, y, _mm256_cmpgt_epi64(lo1, y));
+					hi0 = _mm256_blendv_epi8(hi0, x, _mm256_cmpgt_epi64(x, hi0));
+					hi1 = _mm256_blendv_epi8(hi1, y, _mm256_cmpgt_epi64(y, hi1));
+				}
+				lo0 = _mm256_blendv_epi8(lo0, lo1, _mm256_cmpgt_epi64(lo0, lo1));
+				hi0 = _mm256_blendv_epi8(hi0, hi1, _mm256_cmpgt_epi64(hi1, hi0));
+				alignas(32) long long lo[4], hi[4];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lo), lo0);
+				_mm256_store_si256(reinterpret_cast<__m256i *>(hi), hi0);
+				long long l = lo[0], h = hi[0];
+				for (size_t j = 1; j < 4; ++j)
+				{
+					l = lo[j] < l ? lo[j] : l;
+					h = h < hi[j] ? hi[j] : h;
+				}
+				for (; i < n; ++i)
+				{
+					long long x = static_cast<long long>(p[i] ^ flip);
+					l = x < l ? x : l;
+					h = h < x ? x : h;
+				}
+				lo_out = static_cast<unsigned long long>(l) ^ flip;
+				hi_out = static_cast<unsigned long long>(h) ^ flip;
+			}
+
+			template <class T>
+			SJTU_TARGET_AVX2 typename accum<T>::type sum_avx2(const T *p, size_t n, generic_tag)
+			{
+				return sum_kernel(p, n);
+			}
+			template <class T>
+			typename accum<T>::type sum_avx2(const T *p, size_t n, i32_tag)
+			{
+				const unsigned int *q = reinterpret_cast<const unsigned int *>(p);
+				return static_cast<typename accum<T>::type>(std::is_signed<T>::value ? sum_i32_avx2<true>(q, n) : sum_i32_avx2<false>(q, n));
+			}
+			template <class T>
+			typename accum<T>::type sum_avx2(const T *p, size_t n, i64_tag)
+			{
+				return static_cast<typename accum<T>::type>(sum_i64_avx2(reinterpret_cast<const unsigned long long *>(p), n));
+			}
+			template <class T>
+			typename accum<T>::type sum_avx2(const T *p, size_t n)
+			{
+				return sum_avx2(p, n, std::integral_constant<int, int_width<T>::value>());
+			}
+
+			template <class T>
+			SJTU_TARGET_AVX2 void minmax_avx2(const T *p, size_t n, T &lo, T &hi, generic_tag)
+			{
+				minmax_kernel(p, n, lo, hi);
+			}
+			template <class T>
+			void minmax_avx2(const T *p, size_t n, T &lo, T &hi, i32_tag)
+			{
+				minmax_avx2(p, n, lo, hi, generic_tag()); // 通用内核已能生成 vpminsd/vpmaxsd
+			}
+			template <class T>
+			void minmax_avx2(const T *p, size_t n, T &lo, T &hi, i64_tag)
+			{
+				unsigned long long l, h;
+				minmax_i64_avx2<std::is_signed<T>::value>(reinterpret_cast<const unsigned long long *>(p), n, l, h);
+				lo = static_cast<T>(l);
+				hi = static_cast<T>(h);
+			}
+			template <class T>
+			void minmax_avx2(const T *p, size_t n, T &lo, T &hi)
+			{
+				minmax_avx2(p, n, lo, hi, std::integral_constant<int, int_width<T>::value>());
+			}
+
+			template <class T>
+			SJTU_TARGET_AVX2 size_t find_avx2(const T *p, size_t n, T value, generic_tag)
+			{
+				return find_kernel(p, n, value);
+			}
+			template <class T>
+			size_t find_avx2(const T *p, size_t n, T value, i32_tag)
+			{
+				return find_i32_avx2(reinterpret_cast<const unsigned int *>(p), n, static_cast<unsigned int>(value));
+			}
+			template <class T>
+			size_t find_avx2(const T *p, size_t n, T value, i64_tag)
+			{
+				return find_i64_avx2(reinterpret_cast<const unsigned long long *>(p), n, static_cast<unsigned long long>(value));
+			}
+			template <class T>
+			size_t find_avx2(const T *p, size_t n, T value)
+			{
+				return find_avx2(p, n, value, std::integral_constant<int, int_width<T>::value>());
+			}
+
+			template <class T>
+			SJTU_TARGET_AVX2 size_t count_avx2(const T *p, size_t n, T value, generic_tag)
+			{
+				return count_kernel(p, n, value);
+			}
+			template <class T>
+			size_t count_avx2(const T *p, size_t n, T value, i32_tag)
+			{
+				return count_i32_avx2(reinterpret_cast<const unsigned int *>(p), n, static_cast<unsigned int>(value));
+			}
+			template <class T>
+			size_t count_avx2(const T *p, size_t n, T value, i64_tag)
+			{
+				return count_i64_avx2(reinterpret_cast<const unsigned long long *>(p), n, static_cast<unsigned long long>(value));
+			}
+			template <class T>
+			size_t count_avx2(const T *p, size_t n, T value)
+			{
+				return count_avx2(p, n, value, std::integral_constant<int, int_width<T>::value>());
+			}
+
+			template <class T>
+			SJTU_TARGET_AVX2 typename accum<T>::type dot_avx2(const T *a, const T *b, size_t n)
+			{
+				return dot_kernel(a, b, n);
+			}
+#endif
+
+			template <class T, class Policy, size_t N, class Alloc>
+			const T *data_of(const vector<T, Policy, N, Alloc> &v)
+			{
+				static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, "simd kernels need arithmetic element types");
+				return v.empty() ? nullptr : &v[0];
+			}
+		}
+
+		template <class T, class Policy, size_t N, class Alloc>
+		typename accum<T>::type sum(const vector<T, Policy, N, Alloc> &v)
+		{
+			const T *p = detail::data_of(v);
+#ifdef SJTU_SIMD_DISPATCH
+			if (detail::has_avx2())
+			{
+				return detail::sum_avx2(p, v.size());
+			}
+#endif
+			return detail::sum_kernel(p, v.size());
+		}
+
+		// 返回 (最小值, 最大值)，空 vector 抛出 container_is_empty
+		template <class T, class Policy, size_t N, class Alloc>
+		pair<T, T> minmax(const vector<T, Policy, N, Alloc> &v)
+		{
+			if (v.empty())
+			{
+				throw container_is_empty();
+			}
+			const T *p = detail::data_of(v);
+			T lo, hi;
+#ifdef SJTU_SIMD_DISPATCH
+			if (detail::has_avx2())
+			{
+				detail::minmax_avx2(p, v.size(), lo, hi);
+				return pair<T, T>(lo, hi);
+			}
+#endif
+			detail::minmax_kernel(p, v.size(), lo, hi);
+			return pair<T, T>(lo, hi);
+		}
+
+		// 第一个等于 value 的下标，找不到时返回 v.size()
+		template <class T, class Policy, size_t N, class Alloc>
+		size_t find(const vector<T, Policy, N, Alloc> &v, const T &value)
+		{
+			const T *p = detail::data_of(v);
+#ifdef SJTU_SIMD_DISPATCH
+			if (detail::has_avx2())
+			{
+				return detail::find_avx2(p, v.size(), value);
+			}
+#endif
+			return detail::find_kernel(p, v.size(), value);
+		}
+
+		template <class T, class Policy, size_t N, class Alloc>
+		size_t count(const vector<T, Policy, N, Alloc> &v, const T &value)
+		{
+			const T *p = detail::data_of(v);
+#ifdef SJTU_SIMD_DISPATCH
+			if (detail::has_avx2())
+			{
+				return detail::count_avx2(p, v.size(), value);
+			}
+#endif
+			return detail::count_kernel(p, v.size(), value);
+		}
+
+		// 两者长度不同时抛出 runtime_error
+		template <class T, class P1, size_t N1, class A1, class P2, size_t N2, class A2>
+		typename accum<T>::type dot(const vector<T, P1, N1, A1> &a, const vector<T, P2, N2, A2> &b)
+		{
+			if (a.size() != b.size())
+			{
+				throw runtime_error();
+			}
+			const T *pa = detail::data_of(a);
+			const T *pb = detail::data_of(b);
+#ifdef SJTU_SIMD_DISPATCH
+			if (detail::has_avx2())
+			{
+				return detail::dot_avx2(pa, pb, a.size());
+			}
+#endif
+			return detail::dot_kernel(pa, pb, a.size());
+		}
+	}
+
+}
+
+#undef SJTU_ALWAYS_INLINE
+#ifdef SJTU_SIMD_DISPATCH
+#undef SJTU_TARGET_AVX2
+#undef SJTU_SIMD_DISPATCH
+#endif
+
+#endif
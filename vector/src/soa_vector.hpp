@@ -0,0 +1,596 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <tuple>
+
+// 列存向量：soa_vector<A, B, C> 把每个字段存成一列独立的 vector，
+// 只扫描一两个字段时不会把整条记录读进缓存。各列的扩容、搬移和异常安全都复用 vector，
+// 所有列的长度始终相等；column<I>() 给出一列的连续区间，迭代器解引用得到整条记录的引用元组
+namespace sjtu
+{
+	// 一列的连续区间，begin/end 就是裸指针，适合紧凑循环；所在容器扩容后失效
+	template <typename T>
+	class column_span
+	{
+	private:
+		T *ptr;
+		size_t size_;
+
+	public:
+		column_span(T *ptr_, size_t size) : ptr(ptr_), size_(size) {}
+
+		T &at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return ptr[pos];
+		}
+		T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		T *data() const
+		{
+			return ptr;
+		}
+		T *begin() const
+		{
+			return ptr;
+		}
+		T *end() const
+		{
+			return ptr + size_;
+		}
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		size_t size() const
+		{
+			return size_;
+		}
+	};
+
+	template <typename... Fields>
+	class soa_vector
+	{
+		static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+	public:
+		template <size_t I>
+		using field_type = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+		using value_type = std::tuple<Fields...>;
+		using reference = std::tuple<Fields &...>;
+		using const_reference = std::tuple<const Fields &...>;
+
+	private:
+		using indices = std::index_sequence_for<Fields...>;
+
+		std::tuple<vector<Fields>...> cols; // 每个字段一列
+		size_t size_;						// 记录条数
+
+		template <size_t I>
+		field_type<I> *column_data()
+		{
+			return size_ == 0 ? nullptr : &std::get<I>(cols)[0];
+		}
+		template <size_t I>
+		const field_type<I> *column_data() const
+		{
+			return size_ == 0 ? nullptr : &std::get<I>(cols)[0];
+		}
+
+		template <size_t... Is>
+		reference make_ref(size_t pos, std::index_sequence<Is...>)
+		{
+			return reference(column_data<Is>()[pos]...);
+		}
+		template <size_t... Is>
+		const_reference make_ref(size_t pos, std::index_sequence<Is...>) const
+		{
+			return const_reference(column_data<Is>()[pos]...);
+		}
+
+		// 逐列在 ind 处插入，某一列失败时撤销前面已插入的列，保持各列等长
+		template <size_t I>
+		void insert_fields(size_t)
+		{
+		}
+		template <size_t I, class Arg, class... Rest>
+		void insert_fields(size_t ind, Arg &&arg, Rest &&...rest)
+		{
+			vector<field_type<I>> &col = std::get<I>(cols);
+			if (ind == size_)
+			{
+				col.emplace_back(std::forward<Arg>(arg));
+			}
+			else
+			{
+				col.insert(ind, field_type<I>(std::forward<Arg>(arg)));
+			}
+			try
+			{
+				insert_fields<I + 1>(ind, std::forward<Rest>(rest)...);
+			}
+			catch (...)
+			{
+				col.remove_at(ind); // 就地撤销，不走 erase 以免缩容时重新分配
+				throw;
+			}
+		}
+
+		template <size_t... Is>
+		void erase_fields(size_t ind, std::index_sequence<Is...>)
+		{
+			(std::get<Is>(cols).erase(ind), ...);
+		}
+		template <size_t... Is>
+		void reserve_fields(size_t n, std::index_sequence<Is...>)
+		{
+			(std::get<Is>(cols).reserve(n), ...);
+		}
+		template <size_t... Is>
+		void shrink_fields(std::index_sequence<Is...>)
+		{
+			(std::get<Is>(cols).shrink_to_fit(), ...);
+		}
+		template <size_t... Is>
+		void clear_fields(std::index_sequence<Is...>)
+		{
+			(std::get<Is>(cols).clear(), ...);
+		}
+
+	public:
+		class const_iterator;
+		// 代理迭代器：解引用得到引用元组，不能取 operator->
+		class iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = soa_vector::value_type;
+			using pointer = void;
+			using reference = soa_vector::reference;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class soa_vector;
+			friend class const_iterator;
+
+			soa_vector *vec;
+			size_t pos;
+
+		public:
+			iterator() : vec(nullptr), pos(0) {}
+			iterator(soa_vector *vec_, size_t pos_) : vec(vec_), pos(pos_) {}
+
+			iterator &operator+=(const difference_type &n)
+			{
+				pos += n;
+				return *this;
+			}
+			iterator &operator-=(const difference_type &n)
+			{
+				pos -= n;
+				return *this;
+			}
+			iterator operator+(const difference_type &n) const
+			{
+				return iterator(vec, pos + n);
+			}
+			iterator operator-(const difference_type &n) const
+			{
+				return iterator(vec, pos - n);
+			}
+			friend iterator operator+(const difference_type &n, const iterator &it)
+			{
+				return it + n;
+			}
+			difference_type operator-(const iterator &rhs) const
+			{
+				if (vec != rhs.vec)
+				{
+					throw invalid_iterator();
+				}
+				return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+			}
+
+			iterator &operator++()
+			{
+				++pos;
+				return *this;
+			}
+			iterator operator++(int)
+			{
+				iterator tmp(*this);
+				++pos;
+				return tmp;
+			}
+			iterator &operator--()
+			{
+				--pos;
+				return *this;
+			}
+			iterator operator--(int)
+			{
+				iterator tmp(*this);
+				--pos;
+				return tmp;
+			}
+
+			reference operator*() const
+			{
+				return vec->at(pos);
+			}
+			reference operator[](const difference_type &n) const
+			{
+				return vec->at(pos + n);
+			}
+			// 只取第 I 个字段
+			template <size_t I>
+			field_type<I> &get() const
+			{
+				return vec->template get<I>(pos);
+			}
+
+			bool operator==(const iterator &rhs) const
+			{
+				return vec == rhs.vec && pos == rhs.pos;
+			}
+			bool operator!=(const iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const iterator &rhs) const
+			{
+				return pos < rhs.pos;
+			}
+			bool operator>(const iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		class const_iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = soa_vector::value_type;
+			using pointer = void;
+			using reference = soa_vector::const_reference;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class soa_vector;
+
+			const soa_vector *vec;
+			size_t pos;
+
+		public:
+			const_iterator() : vec(nullptr), pos(0) {}
+			const_iterator(const soa_vector *vec_, size_t pos_) : vec(vec_), pos(pos_) {}
+			const_iterator(const iterator &other) : vec(other.vec), pos(other.pos) {}
+
+			const_iterator &operator+=(const difference_type &n)
+			{
+				pos += n;
+				return *this;
+			}
+			const_iterator &operator-=(const difference_type &n)
+			{
+				pos -= n;
+				return *this;
+			}
+			const_iterator operator+(const difference_type &n) const
+			{
+				return const_iterator(vec, pos + n);
+			}
+			const_iterator operator-(const difference_type &n) const
+			{
+				return const_iterator(vec, pos - n);
+			}
+			friend const_iterator operator+(const difference_type &n, const const_iterator &it)
+			{
+				return it + n;
+			}
+			difference_type operator-(const const_iterator &rhs) const
+			{
+				if (vec != rhs.vec)
+				{
+					throw invalid_iterator();
+				}
+				return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+			}
+
+			const_iterator &operator++()
+			{
+				++pos;
+				return *this;
+			}
+			const_iterator operator++(int)
+			{
+				const_iterator tmp(*this);
+				++pos;
+				return tmp;
+			}
+			const_iterator &operator--()
+			{
+				--pos;
+				return *this;
+			}
+			const_iterator operator--(int)
+			{
+				const_iterator tmp(*this);
+				--pos;
+				return tmp;
+			}
+
+			reference operator*() const
+			{
+				return vec->at(pos);
+			}
+			reference operator[](const difference_type &n) const
+			{
+				return vec->at(pos + n);
+			}
+			template <size_t I>
+			const field_type<I> &get() const
+			{
+				return vec->template get<I>(pos);
+			}
+
+			bool operator==(const const_iterator &rhs) const
+			{
+				return vec == rhs.vec && pos == rhs.pos;
+			}
+			bool operator!=(const const_iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const const_iterator &rhs) const
+			{
+				return pos < rhs.pos;
+			}
+			bool operator>(const const_iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const const_iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const const_iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		soa_vector() : size_(0) {}
+		soa_vector(const soa_vector &other) = default;
+		soa_vector(soa_vector &&other) noexcept : cols(std::move(other.cols)), size_(other.size_)
+		{
+			other.size_ = 0;
+		}
+
+		soa_vector &operator=(const soa_vector &other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			soa_vector tmp(other);
+			*this = std::move(tmp);
+			return *this;
+		}
+		soa_vector &operator=(soa_vector &&other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			cols = std::move(other.cols);
+			size_ = other.size_;
+			other.size_ = 0;
+			return *this;
+		}
+
+		reference at(const size_t &pos)
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return make_ref(pos, indices());
+		}
+		const_reference at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return make_ref(pos, indices());
+		}
+		reference operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		const_reference operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		// 第 pos 条记录的第 I 个字段
+		template <size_t I>
+		field_type<I> &get(const size_t &pos)
+		{
+			return std::get<I>(cols)[pos];
+		}
+		template <size_t I>
+		const field_type<I> &get(const size_t &pos) const
+		{
+			return std::get<I>(cols)[pos];
+		}
+
+		// 第 I 列的连续区间
+		template <size_t I>
+		column_span<field_type<I>> column()
+		{
+			return column_span<field_type<I>>(column_data<I>(), size_);
+		}
+		template <size_t I>
+		column_span<const field_type<I>> column() const
+		{
+			return column_span<const field_type<I>>(column_data<I>(), size_);
+		}
+
+		const_reference front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return make_ref(0, indices());
+		}
+		const_reference back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return make_ref(size_ - 1, indices());
+		}
+
+		iterator begin()
+		{
+			return iterator(this, 0);
+		}
+		const_iterator begin() const
+		{
+			return const_iterator(this, 0);
+		}
+		const_iterator cbegin() const
+		{
+			return const_iterator(this, 0);
+		}
+		iterator end()
+		{
+			return iterator(this, size_);
+		}
+		const_iterator end() const
+		{
+			return const_iterator(this, size_);
+		}
+		const_iterator cend() const
+		{
+			return const_iterator(this, size_);
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		size_t size() const
+		{
+			return size_;
+		}
+		size_t capacity() const
+		{
+			return std::get<0>(cols).capacity();
+		}
+
+		void reserve(size_t n)
+		{
+			reserve_fields(n, indices());
+		}
+		void shrink_to_fit()
+		{
+			shrink_fields(indices());
+		}
+		void clear()
+		{
+			clear_fields(indices());
+			size_ = 0;
+		}
+
+		// 每个参数构造一个字段，参数个数须与字段数相同
+		template <class... Args>
+		reference emplace_back(Args &&...args)
+		{
+			static_assert(sizeof...(Args) == sizeof...(Fields), "one argument per field");
+			insert_fields<0>(size_, std::forward<Args>(args)...);
+			++size_;
+			return make_ref(size_ - 1, indices());
+		}
+		void push_back(const Fields &...values)
+		{
+			emplace_back(values...);
+		}
+		void push_back(const value_type &value)
+		{
+			std::apply([this](const Fields &...values) { emplace_back(values...); }, value);
+		}
+
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			erase(size_ - 1);
+		}
+
+		iterator insert(iterator pos, const Fields &...values)
+		{
+			if (pos.vec != this)
+			{
+				throw invalid_iterator();
+			}
+			return insert(pos.pos, values...);
+		}
+		iterator insert(const size_t &ind, const Fields &...values)
+		{
+			if (ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			insert_fields<0>(ind, values...);
+			++size_;
+			return iterator(this, ind);
+		}
+
+		iterator erase(iterator pos)
+		{
+			if (pos.vec != this)
+			{
+				throw invalid_iterator();
+			}
+			return erase(pos.pos);
+		}
+		iterator erase(const size_t &ind)
+		{
+			if (ind >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			erase_fields(ind, indices());
+			--size_;
+			return iterator(this, ind);
+		}
+	};
+
+}
+
+#endif
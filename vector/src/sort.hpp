@@ -0,0 +1,545 @@
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include "parallel.hpp"
+
+// 排序：sort 为内省排序（三数取中 + 小区间插入排序，递归过深时改用堆排序），
+// stable_sort 为带缓冲的归并排序，radix_sort 为按字节的 LSD 基数排序，支持整数和浮点键。
+// 迭代器版本适用于任意随机访问迭代器；vector 版本直接在底层数组上操作，
+// 并可传入 scratch 在多次排序间复用缓冲区。parallel::sort / stable_sort / radix_sort 为多线程版本
+namespace sjtu
+{
+	namespace detail
+	{
+		const std::ptrdiff_t insertion_cutoff = 16; // 不超过此长度的区间直接插入排序
+		const std::ptrdiff_t merge_cutoff = 32;		// 归并排序的叶子长度
+
+		// 插入排序，相等元素不交换，是稳定的
+		template <class RandomIt, class Compare>
+		void insertion_sort(RandomIt first, RandomIt last, Compare &comp)
+		{
+			if (first == last)
+			{
+				return;
+			}
+			for (RandomIt i = first + 1; i != last; ++i)
+			{
+				typename std::iterator_traits<RandomIt>::value_type tmp(std::move(*i));
+				RandomIt j = i;
+				if (comp(tmp, *first)) // 比首元素还小，整体后移，内层循环因此无需检查边界
+				{
+					for (; j != first; --j)
+					{
+						*j = std::move(*(j - 1));
+					}
+				}
+				else
+				{
+					for (; comp(tmp, *(j - 1)); --j)
+					{
+						*j = std::move(*(j - 1));
+					}
+				}
+				*j = std::move(tmp);
+			}
+		}
+
+		template <class RandomIt, class Compare>
+		void sift_down(RandomIt first, std::ptrdiff_t i, std::ptrdiff_t n, Compare &comp)
+		{
+			typename std::iterator_traits<RandomIt>::value_type tmp(std::move(first[i]));
+			std::ptrdiff_t child;
+			while ((child = 2 * i + 1) < n)
+			{
+				if (child + 1 < n && comp(first[child], first[child + 1]))
+				{
+					++child;
+				}
+				if (!comp(tmp, first[child]))
+				{
+					break;
+				}
+				first[i] = std::move(first[child]);
+				i = child;
+			}
+			first[i] = std::move(tmp);
+		}
+		template <class RandomIt, class Compare>
+		void heap_sort(RandomIt first, RandomIt last, Compare &comp)
+		{
+			std::ptrdiff_t n = last - first;
+			for (std::ptrdiff_t i = n / 2; i-- > 0;)
+			{
+				sift_down(first, i, n, comp);
+			}
+			using std::swap;
+			for (std::ptrdiff_t k = n - 1; k > 0; --k)
+			{
+				swap(first[0], first[k]);
+				sift_down(first, 0, k, comp);
+			}
+		}
+
+		// 把 a、b、c 的中位数换到 result
+		template <class RandomIt, class Compare>
+		void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare &comp)
+		{
+			using std::swap;
+			RandomIt m;
+			if (comp(*a, *b))
+			{
+				m = comp(*b, *c) ? b : (comp(*a, *c) ? c : a);
+			}
+			else
+			{
+				m = comp(*a, *c) ? a : (comp(*b, *c) ? c : b);
+			}
+			swap(*result, *m);
+		}
+
+		// 以 *pivot 为界划分 [first, last)，遇到相等元素也停下交换，大量重复时两侧依然均衡
+		template <class RandomIt, class Compare>
+		RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare &comp)
+		{
+			using std::swap;
+			while (true)
+			{
+				while (comp(*first, *pivot))
+				{
+					++first;
+				}
+				--last;
+				while (comp(*pivot, *last))
+				{
+					--last;
+				}
+				if (!(first < last))
+				{
+					return first;
+				}
+				swap(*first, *last);
+				++first;
+			}
+		}
+
+		template <class RandomIt, class Compare>
+		void intro_loop(RandomIt first, RandomIt last, size_t depth, Compare &comp)
+		{
+			while (last - first > insertion_cutoff)
+			{
+				if (depth == 0)
+				{
+					heap_sort(first, last, comp);
+					return;
+				}
+				--depth;
+				move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+				RandomIt cut = unguarded_partition(first + 1, last, first, comp);
+				intro_loop(cut, last, depth, comp); // 递归右半，循环处理左半
+				last = cut;
+			}
+		}
+
+		template <class RandomIt, class Compare>
+		void intro_sort(RandomIt first, RandomIt last, Compare &comp)
+		{
+			size_t depth = 0;
+			for (std::ptrdiff_t n = last - first; n > 1; n >>= 1)
+			{
+				depth += 2;
+			}
+			intro_loop(first, last, depth, comp);
+			insertion_sort(first, last, comp);
+		}
+
+		// 归并排序，buf 至少能放下一半元素；合并时只把左半搬进缓冲区
+		template <class RandomIt, class T, class Compare>
+		void merge_sort(RandomIt first, RandomIt last, T *buf, Compare &comp)
+		{
+			std::ptrdiff_t n = last - first;
+			if (n <= merge_cutoff)
+			{
+				insertion_sort(first, last, comp);
+				return;
+			}
+			RandomIt mid = first + n / 2;
+			merge_sort(first, mid, buf, comp);
+			merge_sort(mid, last, buf, comp);
+			if (!comp(*mid, *(mid - 1))) // 两半已经有序
+			{
+				return;
+			}
+			T *l = buf;
+			T *le = buf;
+			for (RandomIt i = first; i != mid; ++i)
+			{
+				*le++ = std::move(*i);
+			}
+			RandomIt r = mid;
+			RandomIt out = first;
+			while (l != le && r != last)
+			{
+				if (comp(*r, *l))
+				{
+					*out++ = std::move(*r++);
+				}
+				else
+				{
+					*out++ = std::move(*l++);
+				}
+			}
+			while (l != le)
+			{
+				*out++ = std::move(*l++);
+			}
+		}
+
+		// 让 scratch 至少有 n 个元素，用 sample 拷贝补足，因此不要求 T 可默认构造
+		template <class T, class Policy, size_t N, class Alloc>
+		T *scratch_of(vector<T, Policy, N, Alloc> &scratch, size_t n, const T &sample)
+		{
+			if (scratch.size() < n)
+			{
+				scratch.insert(scratch.size(), n - scratch.size(), sample);
+			}
+			return n == 0 ? nullptr : &scratch[0];
+		}
+
+		// 基数排序的键映射到无符号整数，保持大小顺序
+		template <class K>
+		typename std::enable_if<std::is_integral<K>::value, typename std::make_unsigned<K>::type>::type radix_bits(K key)
+		{
+			using U = typename std::make_unsigned<K>::type;
+			U bits = static_cast<U>(key);
+			if (std::is_signed<K>::value)
+			{
+				bits ^= U(1) << (sizeof(U) * CHAR_BIT - 1); // 翻转符号位
+			}
+			return bits;
+		}
+		template <class U, class F>
+		U float_bits(F key)
+		{
+			U bits;
+			std::memcpy(&bits, &key, sizeof(U));
+			const U sign = U(1) << (sizeof(U) * CHAR_BIT - 1);
+			return (bits & sign) ? ~bits : (bits | sign); // 负数全部取反，正数只置符号位
+		}
+		inline unsigned int radix_bits(float key)
+		{
+			static_assert(sizeof(float) == sizeof(unsigned int), "32-bit float expected");
+			return float_bits<unsigned int>(key);
+		}
+		inline unsigned long long radix_bits(double key)
+		{
+			static_assert(sizeof(double) == sizeof(unsigned long long), "64-bit double expected");
+			return float_bits<unsigned long long>(key);
+		}
+
+		// 可作基数排序键的类型：整数（bool 除外）、float、double。long double 的位宽和填充随平台而异，不支持
+		template <class K>
+		struct is_radix_key : std::integral_constant<bool, (std::is_integral<K>::value && !std::is_same<K, bool>::value) ||
+															   std::is_same<K, float>::value || std::is_same<K, double>::value>
+		{
+		};
+
+		struct radix_identity
+		{
+			template <class T>
+			const T &operator()(const T &value) const
+			{
+				return value;
+			}
+		};
+	}
+
+	template <class RandomIt, class Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+	void sort(RandomIt first, RandomIt last, Compare comp = Compare())
+	{
+		detail::intro_sort(first, last, comp);
+	}
+	template <class T, class Policy, size_t N, class Alloc, class Compare = std::less<T>>
+	void sort(vector<T, Policy, N, Alloc> &v, Compare comp = Compare())
+	{
+		if (v.size() > 1)
+		{
+			detail::intro_sort(&v[0], &v[0] + v.size(), comp);
+		}
+	}
+
+	template <class RandomIt, class Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+	void stable_sort(RandomIt first, RandomIt last, Compare comp = Compare())
+	{
+		using T = typename std::iterator_traits<RandomIt>::value_type;
+		std::ptrdiff_t n = last - first;
+		if (n <= 1)
+		{
+			return;
+		}
+		vector<T> scratch;
+		detail::merge_sort(first, last, detail::scratch_of(scratch, n / 2, *first), comp);
+	}
+	// scratch 为缓冲区，多次排序时传入同一个可避免重复分配
+	template <class T, class Policy, size_t N, class Alloc, class Compare, class P2, size_t N2, class A2>
+	void stable_sort(vector<T, Policy, N, Alloc> &v, Compare comp, vector<T, P2, N2, A2> &scratch)
+	{
+		size_t n = v.size();
+		if (n <= 1)
+		{
+			return;
+		}
+		T *p = &v[0];
+		detail::merge_sort(p, p + n, detail::scratch_of(scratch, n / 2, p[0]), comp);
+	}
+	template <class T, class Policy, size_t N, class Alloc, class Compare = std::less<T>>
+	void stable_sort(vector<T, Policy, N, Alloc> &v, Compare comp = Compare())
+	{
+		vector<T> scratch;
+		stable_sort(v, comp, scratch);
+	}
+
+	// 按 key(元素) 升序稳定排序，键须为整数或浮点数；每轮处理 8 位，全部落在同一桶的轮次直接跳过
+	template <class T, class Policy, size_t N, class Alloc, class Key, class P2, size_t N2, class A2>
+	void radix_sort(vector<T, Policy, N, Alloc> &v, Key key, vector<T, P2, N2, A2> &scratch)
+	{
+		using K = typename std::decay<decltype(key(v[0]))>::type;
+		static_assert(detail::is_radix_key<K>::value, "radix_sort needs integral, float or double keys");
+		using U = decltype(detail::radix_bits(K()));
+		size_t n = v.size();
+		if (n <= 1)
+		{
+			return;
+		}
+		T *src = &v[0];
+		T *dst = detail::scratch_of(scratch, n, src[0]);
+		size_t count[256];
+		for (size_t shift = 0; shift < sizeof(U) * CHAR_BIT; shift += 8)
+		{
+			for (size_t d = 0; d < 256; ++d)
+			{
+				count[d] = 0;
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				++count[(detail::radix_bits(static_cast<K>(key(src[i]))) >> shift) & 0xff];
+			}
+			if (count[(detail::radix_bits(static_cast<K>(key(src[0]))) >> shift) & 0xff] == n)
+			{
+				continue;
+			}
+			size_t sum = 0;
+			for (size_t d = 0; d < 256; ++d)
+			{
+				size_t c = count[d];
+				count[d] = sum;
+				sum += c;
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				dst[count[(detail::radix_bits(static_cast<K>(key(src[i]))) >> shift) & 0xff]++] = std::move(src[i]);
+			}
+			T *tmp = src;
+			src = dst;
+			dst = tmp;
+		}
+		if (src != &v[0])
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				dst[i] = std::move(src[i]);
+			}
+		}
+	}
+	template <class T, class Policy, size_t N, class Alloc, class Key = detail::radix_identity>
+	void radix_sort(vector<T, Policy, N, Alloc> &v, Key key = Key())
+	{
+		vector<T> scratch;
+		radix_sort(v, key, scratch);
+	}
+
+	namespace parallel
+	{
+		namespace detail
+		{
+			// 稳定合并 [a, ae) 与 [b, be) 到 out
+			template <class T, class Compare>
+			void merge_move(T *a, T *ae, T *b, T *be, T *out, Compare &comp)
+			{
+				while (a != ae && b != be)
+				{
+					if (comp(*b, *a))
+					{
+						*out++ = std::move(*b++);
+					}
+					else
+					{
+						*out++ = std::move(*a++);
+					}
+				}
+				while (a != ae)
+				{
+					*out++ = std::move(*a++);
+				}
+				while (b != be)
+				{
+					*out++ = std::move(*b++);
+				}
+			}
+
+			// 各块并行用 sort_run 排好，再逐轮两两并行合并，在 v 与缓冲区之间来回搬
+			template <class T, class Policy, size_t N, class Alloc, class Compare, class SortRun>
+			void block_sort(vector<T, Policy, N, Alloc> &v, Compare &comp, const options &opt, SortRun sort_run)
+			{
+				size_t n = v.size();
+				if (n <= 1)
+				{
+					return;
+				}
+				thread_pool &pool = pool_of(opt);
+				size_t grain = opt.grain != 0 ? opt.grain : (n + pool.size() - 1) / pool.size();
+				if (grain < 4096)
+				{
+					grain = 4096;
+				}
+				T *p = &v[0];
+				if (grain >= n)
+				{
+					sort_run(p, p + n);
+					return;
+				}
+				pool.run(blocks_of(n, grain), [&](size_t b) {
+					size_t l = b * grain;
+					sort_run(p + l, p + (l + grain < n ? l + grain : n));
+				});
+				vector<T> buf;
+				T *src = p;
+				T *dst = sjtu::detail::scratch_of(buf, n, p[0]);
+				for (size_t width = grain; width < n; width *= 2)
+				{
+					pool.run(blocks_of(n, 2 * width), [&](size_t k) {
+						size_t l = k * 2 * width;
+						size_t m = l + width < n ? l + width : n;
+						size_t r = m + width < n ? m + width : n;
+						merge_move(src + l, src + m, src + m, src + r, dst + l, comp);
+					});
+					T *tmp = src;
+					src = dst;
+					dst = tmp;
+				}
+				if (src != p)
+				{
+					pool.run(blocks_of(n, grain), [&](size_t b) {
+						size_t l = b * grain;
+						size_t r = l + grain < n ? l + grain : n;
+						for (size_t i = l; i < r; ++i)
+						{
+							p[i] = std::move(src[i]);
+						}
+					});
+				}
+			}
+		}
+
+		template <class T, class Policy, size_t N, class Alloc, class Compare = std::less<T>>
+		void sort(vector<T, Policy, N, Alloc> &v, Compare comp = Compare(), const options &opt = options())
+		{
+			detail::block_sort(v, comp, opt, [&](T *first, T *last) {
+				sjtu::detail::intro_sort(first, last, comp);
+			});
+		}
+		template <class T, class Policy, size_t N, class Alloc, class Compare = std::less<T>>
+		void stable_sort(vector<T, Policy, N, Alloc> &v, Compare comp = Compare(), const options &opt = options())
+		{
+			detail::block_sort(v, comp, opt, [&](T *first, T *last) {
+				vector<T> scratch; // 每块各用一个缓冲区
+				sjtu::detail::merge_sort(first, last, sjtu::detail::scratch_of(scratch, (last - first) / 2, *first), comp);
+			});
+		}
+
+		// 多线程基数排序，结果与 sjtu::radix_sort 相同（稳定）。每轮各块并行统计自己的直方图，
+		// 再按“桶为主、块为次”的顺序求前缀和，得到每块每桶的写入起点，各块并行分发，互不冲突
+		template <class T, class Policy, size_t N, class Alloc, class Key, class P2, size_t N2, class A2>
+		void radix_sort(vector<T, Policy, N, Alloc> &v, Key key, vector<T, P2, N2, A2> &scratch, const options &opt = options())
+		{
+			using K = typename std::decay<decltype(key(v[0]))>::type;
+			static_assert(sjtu::detail::is_radix_key<K>::value, "radix_sort needs integral, float or double keys");
+			using U = decltype(sjtu::detail::radix_bits(K()));
+			size_t n = v.size();
+			if (n <= 1)
+			{
+				return;
+			}
+			size_t blocks = detail::blocks_of(n, detail::grain_of(opt, n));
+			T *src = &v[0];
+			T *dst = sjtu::detail::scratch_of(scratch, n, src[0]);
+			vector<size_t> count; // count[b * 256 + d]：第 b 块中第 d 个桶的元素数，之后改为写入位置
+			detail::prepare(count, blocks * 256);
+			size_t *cnt = &count[0];
+			auto digit = [&](const T &x, size_t shift) {
+				return static_cast<size_t>((sjtu::detail::radix_bits(static_cast<K>(key(x))) >> shift) & 0xff);
+			};
+			for (size_t shift = 0; shift < sizeof(U) * CHAR_BIT; shift += 8)
+			{
+				detail::for_blocks(n, opt, [&](size_t l, size_t r, size_t b) {
+					size_t *c = cnt + b * 256;
+					for (size_t d = 0; d < 256; ++d)
+					{
+						c[d] = 0;
+					}
+					for (size_t i = l; i < r; ++i)
+					{
+						++c[digit(src[i], shift)];
+					}
+				});
+				size_t first = digit(src[0], shift);
+				size_t same = 0;
+				for (size_t b = 0; b < blocks; ++b)
+				{
+					same += cnt[b * 256 + first];
+				}
+				if (same == n)
+				{
+					continue;
+				}
+				size_t sum = 0;
+				for (size_t d = 0; d < 256; ++d)
+				{
+					for (size_t b = 0; b < blocks; ++b)
+					{
+						size_t c = cnt[b * 256 + d];
+						cnt[b * 256 + d] = sum;
+						sum += c;
+					}
+				}
+				detail::for_blocks(n, opt, [&](size_t l, size_t r, size_t b) {
+					size_t *c = cnt + b * 256;
+					for (size_t i = l; i < r; ++i)
+					{
+						dst[c[digit(src[i], shift)]++] = std::move(src[i]);
+					}
+				});
+				T *tmp = src;
+				src = dst;
+				dst = tmp;
+			}
+			if (src != &v[0])
+			{
+				detail::for_blocks(n, opt, [&](size_t l, size_t r, size_t) {
+					for (size_t i = l; i < r; ++i)
+					{
+						dst[i] = std::move(src[i]);
+					}
+				});
+			}
+		}
+		template <class T, class Policy, size_t N, class Alloc, class Key = sjtu::detail::radix_identity>
+		void radix_sort(vector<T, Policy, N, Alloc> &v, Key key = Key(), const options &opt = options())
+		{
+			vector<T> scratch;
+			parallel::radix_sort(v, key, scratch, opt);
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef SJTU_STATIC_VECTOR_HPP
+#define SJTU_STATIC_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+// 定容向量：最多 N 个元素，全部存放在对象内部，从不申请堆内存。
+// 接口与 vector 一致；超出容量时的行为由 Overflow 在编译期决定。
+// T 可平凡析构、可默认构造且可移动赋值时，整个容器是字面类型，可以在 constexpr 函数中使用
+namespace sjtu
+{
+	// 溢出时抛出 index_out_of_bound
+	struct throw_on_overflow
+	{
+		static void overflow()
+		{
+			throw index_out_of_bound();
+		}
+	};
+	// 溢出时断言失败；定义了 NDEBUG 时断言不生效，仍直接 abort，不会越界写
+	struct assert_on_overflow
+	{
+		static void overflow()
+		{
+			assert(false && "static_vector overflow");
+			std::abort();
+		}
+	};
+
+	// constexpr 下不能在原始内存上构造对象，只能先把数组值初始化、再赋值；
+	// 这要求 T 可默认构造、可移动赋值，且无需析构（未用的位置不会被析构）
+	template <typename T>
+	struct static_vector_literal
+		: std::integral_constant<bool, std::is_trivially_destructible<T>::value && std::is_default_constructible<T>::value &&
+										   std::is_move_assignable<T>::value>
+	{
+	};
+
+	// 存储层：一般类型用未构造的原始内存，按需构造和析构
+	template <typename T, size_t N, bool Literal = static_vector_literal<T>::value>
+	class static_vector_storage
+	{
+	protected:
+		alignas(T) unsigned char buf[(N == 0 ? 1 : N) * sizeof(T)];
+		size_t size_ = 0;
+
+		T *ptr()
+		{
+			return reinterpret_cast<T *>(buf);
+		}
+		const T *ptr() const
+		{
+			return reinterpret_cast<const T *>(buf);
+		}
+		template <class... Args>
+		void construct(size_t i, Args &&...args)
+		{
+			new (ptr() + i) T(std::forward<Args>(args)...);
+		}
+		void destroy(size_t i)
+		{
+			(ptr() + i)->~T();
+		}
+
+		static_vector_storage() {}
+		static_vector_storage(const static_vector_storage &) = delete;
+		static_vector_storage &operator=(const static_vector_storage &) = delete;
+		~static_vector_storage()
+		{
+			for (size_t i = 0; i < size_; ++i)
+			{
+				destroy(i);
+			}
+		}
+	};
+
+	// 存储层：可平凡析构的类型直接用值初始化的数组，“构造”就是赋值，析构为平凡析构。
+	// 每次构造容器都要把 N 个元素值初始化一遍：平凡类型是一次清零，
+	// 有默认构造函数的类型会调用它 N 次，emplace 时再构造一个临时对象移动赋值过去；
+	// 需要析构的类型走上面的原始内存，不为未用的位置付出任何代价
+	template <typename T, size_t N>
+	class static_vector_storage<T, N, true>
+	{
+	protected:
+		T elems[N == 0 ? 1 : N] = {};
+		size_t size_ = 0;
+
+		constexpr T *ptr()
+		{
+			return elems;
+		}
+		constexpr const T *ptr() const
+		{
+			return elems;
+		}
+		template <class... Args>
+		constexpr void construct(size_t i, Args &&...args)
+		{
+			elems[i] = T(std::forward<Args>(args)...);
+		}
+		constexpr void destroy(size_t) {}
+
+		constexpr static_vector_storage() {}
+		static_vector_storage(const static_vector_storage &) = delete;
+		static_vector_storage &operator=(const static_vector_storage &) = delete;
+	};
+
+	template <typename T, size_t N, class Overflow = throw_on_overflow>
+	class static_vector : private static_vector_storage<T, N>
+	{
+	private:
+		using base = static_vector_storage<T, N>;
+		using base::construct;
+		using base::destroy;
+		using base::ptr;
+		using base::size_;
+
+		constexpr void copy_from(const static_vector &other)
+		{
+			for (; size_ < other.size_; ++size_)
+			{
+				construct(size_, other.ptr()[size_]);
+			}
+		}
+		constexpr void move_from(static_vector &other)
+		{
+			for (; size_ < other.size_; ++size_)
+			{
+				construct(size_, std::move(other.ptr()[size_]));
+			}
+		}
+
+	public:
+		using iterator = T *;
+		using const_iterator = const T *;
+
+		constexpr static_vector() {}
+		constexpr static_vector(const static_vector &other)
+		{
+			copy_from(other);
+		}
+		constexpr static_vector(static_vector &&other)
+		{
+			move_from(other);
+		}
+		constexpr static_vector &operator=(const static_vector &other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			clear();
+			copy_from(other);
+			return *this;
+		}
+		constexpr static_vector &operator=(static_vector &&other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			clear();
+			move_from(other);
+			return *this;
+		}
+
+		constexpr T &at(const size_t &pos)
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return ptr()[pos];
+		}
+		constexpr const T &at(const size_t &pos) const
+		{
+			if (pos >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			return ptr()[pos];
+		}
+		constexpr T &operator[](const size_t &pos)
+		{
+			return at(pos);
+		}
+		constexpr const T &operator[](const size_t &pos) const
+		{
+			return at(pos);
+		}
+
+		constexpr const T &front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return ptr()[0];
+		}
+		constexpr const T &back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return ptr()[size_ - 1];
+		}
+
+		constexpr T *data()
+		{
+			return ptr();
+		}
+		constexpr const T *data() const
+		{
+			return ptr();
+		}
+
+		constexpr iterator begin()
+		{
+			return ptr();
+		}
+		constexpr const_iterator begin() const
+		{
+			return ptr();
+		}
+		constexpr const_iterator cbegin() const
+		{
+			return ptr();
+		}
+		constexpr iterator end()
+		{
+			return ptr() + size_;
+		}
+		constexpr const_iterator end() const
+		{
+			return ptr() + size_;
+		}
+		constexpr const_iterator cend() const
+		{
+			return ptr() + size_;
+		}
+
+		constexpr bool empty() const
+		{
+			return size_ == 0;
+		}
+		constexpr bool full() const
+		{
+			return size_ == N;
+		}
+		constexpr size_t size() const
+		{
+			return size_;
+		}
+		static constexpr size_t capacity()
+		{
+			return N;
+		}
+
+		constexpr void clear()
+		{
+			while (size_ != 0)
+			{
+				destroy(--size_);
+			}
+		}
+
+		template <class... Args>
+		constexpr T &emplace_back(Args &&...args)
+		{
+			if (size_ >= N)
+			{
+				Overflow::overflow();
+			}
+			construct(size_, std::forward<Args>(args)...);
+			return ptr()[size_++];
+		}
+		constexpr void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+		constexpr void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		constexpr void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			destroy(--size_);
+		}
+
+		// 迭代器就是指针，写成模板以免字面量 0 与下标重载产生歧义
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		constexpr iterator insert(It pos, const T &value)
+		{
+			return insert(static_cast<size_t>(pos - begin()), value);
+		}
+		constexpr iterator insert(const size_t &ind, const T &value)
+		{
+			if (ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			if (size_ >= N)
+			{
+				Overflow::overflow();
+			}
+			T tmp(value); // value 可能引用自身元素
+			T *p = ptr();
+			if (ind == size_)
+			{
+				construct(size_, std::move(tmp));
+			}
+			else
+			{
+				construct(size_, std::move(p[size_ - 1]));
+				for (size_t i = size_ - 1; i > ind; --i)
+				{
+					p[i] = std::move(p[i - 1]);
+				}
+				p[ind] = std::move(tmp);
+			}
+			++size_;
+			return begin() + ind;
+		}
+
+		template <class It, class = typename std::enable_if<std::is_same<It, iterator>::value>::type>
+		constexpr iterator erase(It pos)
+		{
+			return erase(static_cast<size_t>(pos - begin()));
+		}
+		constexpr iterator erase(const size_t &ind)
+		{
+			if (ind >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			T *p = ptr();
+			for (size_t i = ind; i + 1 < size_; ++i)
+			{
+				p[i] = std::move(p[i + 1]);
+			}
+			destroy(--size_);
+			return begin() + ind;
+		}
+	};
+
+}
+
+#endif
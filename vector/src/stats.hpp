@@ -0,0 +1,161 @@
+#ifndef SJTU_STATS_HPP
+#define SJTU_STATS_HPP
+
+#include <cstddef>
+
+#ifdef SJTU_VECTOR_STATS
+#include <atomic>
+#endif
+
+// vector 的分配与搬移统计：定义 SJTU_VECTOR_STATS 后编译进来，每个 vector 各记一份，
+// 同时累加到进程全局计数（原子计数，可跨线程）。未定义时探针是空基类，各钩子为空函数，
+// 不占对象空间也不产生任何代码，stats::vector() 和 vector::stats() 恒返回全 0
+namespace sjtu
+{
+	namespace stats
+	{
+		struct vector_counters
+		{
+			size_t allocations = 0;	   // 堆分配次数
+			size_t deallocations = 0;  // 堆释放次数
+			size_t reallocations = 0;  // 换缓冲区的次数（扩容、缩容、reserve、shrink_to_fit）
+			size_t relocated = 0;	   // 换缓冲区时搬移的元素个数
+			size_t relocated_bytes = 0; // 同上，按字节计
+			size_t shifted = 0;		   // 原地插入删除时为开合空位而挪动的元素个数
+			size_t peak_capacity = 0;  // 分配过的最大容量（元素个数）
+		};
+
+#ifdef SJTU_VECTOR_STATS
+		const bool enabled = true;
+
+		namespace detail
+		{
+			struct vector_totals
+			{
+				std::atomic<size_t> allocations{0};
+				std::atomic<size_t> deallocations{0};
+				std::atomic<size_t> reallocations{0};
+				std::atomic<size_t> relocated{0};
+				std::atomic<size_t> relocated_bytes{0};
+				std::atomic<size_t> shifted{0};
+				std::atomic<size_t> peak_capacity{0};
+			};
+			inline vector_totals &totals()
+			{
+				static vector_totals t;
+				return t;
+			}
+			inline void bump(std::atomic<size_t> &c, size_t n)
+			{
+				c.fetch_add(n, std::memory_order_relaxed);
+			}
+			inline void raise(std::atomic<size_t> &c, size_t n)
+			{
+				size_t cur = c.load(std::memory_order_relaxed);
+				while (cur < n && !c.compare_exchange_weak(cur, n, std::memory_order_relaxed))
+				{
+				}
+			}
+		}
+
+		// 全局计数的快照，各字段分别读取，并发修改时彼此之间不保证一致
+		inline vector_counters vector()
+		{
+			detail::vector_totals &t = detail::totals();
+			vector_counters c;
+			c.allocations = t.allocations.load(std::memory_order_relaxed);
+			c.deallocations = t.deallocations.load(std::memory_order_relaxed);
+			c.reallocations = t.reallocations.load(std::memory_order_relaxed);
+			c.relocated = t.relocated.load(std::memory_order_relaxed);
+			c.relocated_bytes = t.relocated_bytes.load(std::memory_order_relaxed);
+			c.shifted = t.shifted.load(std::memory_order_relaxed);
+			c.peak_capacity = t.peak_capacity.load(std::memory_order_relaxed);
+			return c;
+		}
+		inline void reset_vector()
+		{
+			detail::vector_totals &t = detail::totals();
+			t.allocations.store(0, std::memory_order_relaxed);
+			t.deallocations.store(0, std::memory_order_relaxed);
+			t.reallocations.store(0, std::memory_order_relaxed);
+			t.relocated.store(0, std::memory_order_relaxed);
+			t.relocated_bytes.store(0, std::memory_order_relaxed);
+			t.shifted.store(0, std::memory_order_relaxed);
+			t.peak_capacity.store(0, std::memory_order_relaxed);
+		}
+
+		// 挂在每个 vector 上的探针；拷贝或移动 vector 时不随之转移，新对象从 0 开始计
+		class vector_probe
+		{
+		private:
+			vector_counters local;
+
+		public:
+			vector_probe() {}
+			vector_probe(const vector_probe &) {}
+			vector_probe &operator=(const vector_probe &)
+			{
+				return *this;
+			}
+
+			void on_allocate(size_t cap)
+			{
+				++local.allocations;
+				if (local.peak_capacity < cap)
+				{
+					local.peak_capacity = cap;
+				}
+				detail::bump(detail::totals().allocations, 1);
+				detail::raise(detail::totals().peak_capacity, cap);
+			}
+			void on_deallocate()
+			{
+				++local.deallocations;
+				detail::bump(detail::totals().deallocations, 1);
+			}
+			void on_reallocate(size_t n, size_t bytes)
+			{
+				++local.reallocations;
+				local.relocated += n;
+				local.relocated_bytes += bytes;
+				detail::bump(detail::totals().reallocations, 1);
+				detail::bump(detail::totals().relocated, n);
+				detail::bump(detail::totals().relocated_bytes, bytes);
+			}
+			void on_shift(size_t n)
+			{
+				local.shifted += n;
+				detail::bump(detail::totals().shifted, n);
+			}
+			vector_counters counters() const
+			{
+				return local;
+			}
+		};
+#else
+		const bool enabled = false;
+
+		inline vector_counters vector()
+		{
+			return vector_counters();
+		}
+		inline void reset_vector() {}
+
+		class vector_probe
+		{
+		public:
+			void on_allocate(size_t) {}
+			void on_deallocate() {}
+			void on_reallocate(size_t, size_t) {}
+			void on_shift(size_t) {}
+			vector_counters counters() const
+			{
+				return vector_counters();
+			}
+		};
+#endif
+	}
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "serialize.hpp"
+#include "stats.hpp"
 
 #include <climits>
 #include <cstddef>
@@ -10,19 +12,329 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 // 参考资料：stl源码解析
 namespace sjtu
 {
+	// 可平凡重定位：对象可以整块 memmove 到新地址而无需调用构造/析构。
+	// 平凡可拷贝类型默认满足，其他类型（如仅持有堆指针的类）可自行特化为 true
 	template <typename T>
-	class vector
+	struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+	{
+	};
+
+	// 容量策略：按 GrowNum/GrowDen 倍扩容；元素数降到容量的 1/ShrinkDiv 以下时缩到一半。
+	// ShrinkDiv > 2 保证缩容后仍有一半空余，边界处交替 push/pop 不会反复重分配；
+	// ShrinkDiv 为 0 表示从不自动缩容
+	template <size_t GrowNum = 2, size_t GrowDen = 1, size_t ShrinkDiv = 4>
+	struct growth_policy
+	{
+		static_assert(GrowNum > GrowDen, "growth factor must be greater than 1");
+		static_assert(ShrinkDiv == 0 || ShrinkDiv > 2, "shrink threshold needs hysteresis");
+
+		static size_t grow(size_t cap)
+		{
+			if (cap < 2)
+			{
+				return 2;
+			}
+			size_t new_cap = cap / GrowDen * GrowNum + cap % GrowDen * GrowNum / GrowDen;
+			return new_cap > cap ? new_cap : cap + 1;
+		}
+		static bool should_shrink(size_t size, size_t cap)
+		{
+			return ShrinkDiv != 0 && cap > 1 && size <= cap / ShrinkDiv;
+		}
+	};
+
+	using default_growth_policy = growth_policy<2, 1, 4>;
+	using no_shrink_policy = growth_policy<2, 1, 0>;
+
+	// 内联存储：对象内预留 N 个未构造的 T；N 为 0 时是空类，借空基类优化不占空间
+	template <typename T, size_t N>
+	struct inline_storage
+	{
+		alignas(T) unsigned char buf[N * sizeof(T)];
+
+		T *inline_data()
+		{
+			return reinterpret_cast<T *>(buf);
+		}
+	};
+	template <typename T>
+	struct inline_storage<T, 0>
+	{
+		T *inline_data()
+		{
+			return nullptr;
+		}
+	};
+
+	template <typename... Fields>
+	class soa_vector;
+
+	// N 为内联容量：不超过 N 个元素时不分配堆内存，见下方 small_vector
+	// Alloc 遵循 std::allocator_traits 的传播规则，可换成 arena.hpp 中的 arena_allocator
+	// 定义 SJTU_VECTOR_STATS 时记录分配与搬移次数，见 stats.hpp
+	template <typename T, class Policy = default_growth_policy, size_t N = 0, class Alloc = std::allocator<T>>
+	class vector : private inline_storage<T, N>, private stats::vector_probe
 	{
 	private:
-		T *data;				 // 存储数据
-		size_t size_;			 // 已占容量
-		size_t capacity;		 // 总容量
-		std::allocator<T> alloc; // 空间配置器
+		using alloc_traits = std::allocator_traits<Alloc>;
+
+		T *data;		  // 存储数据
+		size_t size_;	  // 已占容量
+		size_t capacity_; // 总容量
+		Alloc alloc;	  // 空间配置器
+
+		template <typename... Fields>
+		friend class soa_vector; // 插入失败回滚时要用 remove_at，不能触发缩容
+
+		bool is_inline(const T *p)
+		{
+			return N != 0 && p == this->inline_data();
+		}
+		T *acquire(size_t cap)
+		{
+			if (cap <= N)
+			{
+				return this->inline_data();
+			}
+			T *p = alloc_traits::allocate(alloc, cap);
+			this->on_allocate(cap);
+			return p;
+		}
+		void release(T *p, size_t cap)
+		{
+			if (p != nullptr && !is_inline(p))
+			{
+				alloc_traits::deallocate(alloc, p, cap);
+				this->on_deallocate();
+			}
+		}
+		void destroy_all()
+		{
+			for (size_t i = 0; i < size_; ++i)
+			{
+				(data + i)->~T();
+			}
+			size_ = 0;
+		}
+		// 在已预留的空间中逐个拷贝 other 的元素，要求当前为空
+		void copy_from(const vector &other)
+		{
+			for (; size_ < other.size_; ++size_)
+			{
+				new (data + size_) T(other.data[size_]);
+			}
+		}
+		// 逐个移动 other 的元素，要求当前为空；other 留空
+		void move_from(vector &other)
+		{
+			reserve(other.size_);
+			for (; size_ < other.size_; ++size_)
+			{
+				new (data + size_) T(std::move(other.data[size_]));
+			}
+			other.destroy_all();
+		}
+		// 接管 other 的元素，要求当前为空、无堆内存且两者空间配置器相等；other 留空
+		void steal_from(vector &other)
+		{
+			if (other.is_inline(other.data))
+			{
+				move_from(other);
+				return;
+			}
+			data = other.data;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.data = other.inline_data();
+			other.size_ = 0;
+			other.capacity_ = N;
+		}
+
+		// 重新分配到 new_cap，同时可在 gap 处留出 gap_n 个未构造的位置：
+		// 可平凡重定位时整块 memcpy；否则 move 构造不抛异常时移动，再否则拷贝以保持强异常安全
+		void reallocate(size_t new_cap, size_t gap = 0, size_t gap_n = 0)
+		{
+			if (new_cap <= N)
+			{
+				if (is_inline(data))
+				{
+					open_gap(gap, gap_n);
+					return;
+				}
+				new_cap = N;
+			}
+			T *tmp = acquire(new_cap);
+			if (is_trivially_relocatable<T>::value)
+			{
+				if (gap != 0)
+				{
+					std::memcpy(static_cast<void *>(tmp), static_cast<const void *>(data), gap * sizeof(T));
+				}
+				if (size_ != gap)
+				{
+					std::memcpy(static_cast<void *>(tmp + gap + gap_n), static_cast<const void *>(data + gap), (size_ - gap) * sizeof(T));
+				}
+			}
+			else
+			{
+				size_t i = 0;
+				try
+				{
+					for (; i < size_; ++i)
+					{
+						new (tmp + (i < gap ? i : i + gap_n)) T(std::move_if_noexcept(data[i]));
+					}
+				}
+				catch (...)
+				{
+					for (size_t j = 0; j < i; ++j)
+					{
+						(tmp + (j < gap ? j : j + gap_n))->~T();
+					}
+					release(tmp, new_cap);
+					throw;
+				}
+				for (size_t j = 0; j < size_; ++j)
+				{
+					(data + j)->~T();
+				}
+			}
+			this->on_reallocate(size_, size_ * sizeof(T));
+			release(data, capacity_);
+			data = tmp;
+			capacity_ = new_cap;
+		}
+
+		// 在 ind 处空出 n 个未构造的位置，要求 size_ + n <= capacity_；size_ 不变
+		void open_gap(size_t ind, size_t n = 1)
+		{
+			if (n == 0 || ind == size_)
+			{
+				return;
+			}
+			this->on_shift(size_ - ind);
+			if (is_trivially_relocatable<T>::value)
+			{
+				std::memmove(static_cast<void *>(data + ind + n), static_cast<const void *>(data + ind), (size_ - ind) * sizeof(T));
+				return;
+			}
+			for (size_t i = size_; i-- > ind;)
+			{
+				if (i + n >= size_)
+				{
+					new (data + i + n) T(std::move(data[i]));
+				}
+				else
+				{
+					data[i + n] = std::move(data[i]);
+				}
+			}
+			size_t end = ind + n < size_ ? ind + n : size_;
+			for (size_t i = ind; i < end; ++i)
+			{
+				(data + i)->~T();
+			}
+		}
+
+		// 合上 ind 处 n 个未构造的位置，此时尾部元素位于 [ind + n, size_ + n)
+		void close_gap(size_t ind, size_t n = 1)
+		{
+			if (n == 0 || ind == size_)
+			{
+				return;
+			}
+			this->on_shift(size_ - ind);
+			if (is_trivially_relocatable<T>::value)
+			{
+				std::memmove(static_cast<void *>(data + ind), static_cast<const void *>(data + ind + n), (size_ - ind) * sizeof(T));
+				return;
+			}
+			for (size_t i = ind; i < size_; ++i)
+			{
+				if (i < ind + n)
+				{
+					new (data + i) T(std::move(data[i + n]));
+				}
+				else
+				{
+					data[i] = std::move(data[i + n]);
+				}
+			}
+			for (size_t i = (ind + n > size_ ? ind + n : size_); i < size_ + n; ++i)
+			{
+				(data + i)->~T();
+			}
+		}
+
+		// 析构 ind 处的元素并合上空位，不缩容也不重新分配
+		void remove_at(size_t ind)
+		{
+			(data + ind)->~T();
+			--size_;
+			close_gap(ind);
+		}
+
+		// 在 ind 处留出 n 个位置，空间不足时只重新分配一次
+		void make_gap(size_t ind, size_t n)
+		{
+			if (size_ + n <= capacity_)
+			{
+				open_gap(ind, n);
+				return;
+			}
+			size_t new_cap = Policy::grow(capacity_);
+			reallocate(new_cap > size_ + n ? new_cap : size_ + n, ind, n);
+		}
+
+		// 从 first 开始依次构造 [ind, ind + n)，失败时合上空位
+		template <class ForwardIt>
+		void fill_gap(size_t ind, size_t n, ForwardIt first)
+		{
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i, ++first)
+				{
+					new (data + ind + i) T(*first);
+				}
+			}
+			catch (...)
+			{
+				for (size_t j = 0; j < i; ++j)
+				{
+					(data + ind + j)->~T();
+				}
+				close_gap(ind, n);
+				throw;
+			}
+			size_ += n;
+		}
+
+		template <class InputIt>
+		void insert_range(size_t ind, InputIt first, InputIt last, std::input_iterator_tag)
+		{
+			vector tmp(alloc);
+			for (; first != last; ++first)
+			{
+				tmp.push_back(*first);
+			}
+			insert_range(ind, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()), std::forward_iterator_tag());
+		}
+		template <class ForwardIt>
+		void insert_range(size_t ind, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+		{
+			size_t n = std::distance(first, last);
+			make_gap(ind, n);
+			fill_gap(ind, n, first);
+		}
 
 	public:
 		class const_iterator;
@@ -44,119 +356,1007 @@ namespace sjtu
 			using value_type = T;
 			using pointer = T *;
 			using reference = T &;
-			using iterator_category = std::output_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
 
 		private:
-			size_t pos;	 // 迭代器位置
-			vector *vec; // 指向容器
-		public:
-			iterator() : pos(0), vec(nullptr) {}
-			iterator(size_t position, vector *v) : pos(position), vec(v) {}
-			iterator(const iterator &other) : pos(other.pos), vec(other.vec) {}
+			friend class vector;
+			friend class const_iterator;
+
+			T *ptr; // 发布模式下迭代器就是裸指针
+#ifdef SJTU_CHECKED_ITERATORS
+			const vector *vec; // 调试模式额外记录所属容器
 
-			iterator operator+(const int &n) const
+			void check_offset(difference_type n) const
 			{
-				if (pos + n > vec->size_)
+				if (vec == nullptr)
+				{
+					throw invalid_iterator();
+				}
+				difference_type pos = ptr - vec->data + n;
+				if (pos < 0 || pos > static_cast<difference_type>(vec->size_))
 				{
 					throw index_out_of_bound();
 				}
-				return iterator(pos + n, vec);
 			}
-			iterator operator-(const int &n) const
+			void check_deref() const
 			{
-				if (pos - n < 0)
+				check_offset(0);
+				if (ptr == vec->data + vec->size_)
 				{
 					throw index_out_of_bound();
 				}
-				return iterator(pos - n, vec);
 			}
-
-			int operator-(const iterator &rhs) const
+			void check_same(const vector *other) const
 			{
-				if (vec != rhs.vec)
+				if (vec != other)
 				{
 					throw invalid_iterator();
 				}
-				return pos - rhs.pos;
 			}
-			iterator &operator+=(const int &n)
+#else
+			void check_offset(difference_type) const {}
+			void check_deref() const {}
+			void check_same(const vector *) const {}
+#endif
+
+		public:
+#ifdef SJTU_CHECKED_ITERATORS
+			iterator() : ptr(nullptr), vec(nullptr) {}
+			iterator(T *p, const vector *v) : ptr(p), vec(v) {}
+			const vector *owner() const { return vec; }
+#else
+			iterator() : ptr(nullptr) {}
+			iterator(T *p, const vector *) : ptr(p) {}
+			const vector *owner() const { return nullptr; }
+#endif
+
+			iterator operator+(const difference_type &n) const
+			{
+				iterator tmp(*this);
+				return tmp += n;
+			}
+			iterator operator-(const difference_type &n) const
 			{
-				if (pos + n > vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				pos += n;
+				iterator tmp(*this);
+				return tmp -= n;
+			}
+			friend iterator operator+(const difference_type &n, const iterator &it)
+			{
+				return it + n;
+			}
+
+			difference_type operator-(const iterator &rhs) const
+			{
+				check_same(rhs.owner());
+				return ptr - rhs.ptr;
+			}
+			iterator &operator+=(const difference_type &n)
+			{
+				check_offset(n);
+				ptr += n;
 				return *this;
 			}
-			iterator &operator-=(const int &n)
+			iterator &operator-=(const difference_type &n)
 			{
-				if (pos - n < 0)
-				{
-					throw index_out_of_bound();
-				}
-				pos -= n;
+				check_offset(-n);
+				ptr -= n;
 				return *this;
 			}
 
 			iterator operator++(int)
 			{
-				if (pos + 1 > vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				return iterator(pos + 1, vec);
+				iterator tmp(*this);
+				++*this;
+				return tmp;
 			}
-
 			iterator &operator++()
 			{
-				if (pos + 1 > vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				++pos;
+				check_offset(1);
+				++ptr;
 				return *this;
 			}
 
 			iterator operator--(int)
 			{
-				if (pos < 1)
+				iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+			iterator &operator--()
+			{
+				check_offset(-1);
+				--ptr;
+				return *this;
+			}
+
+			T &operator*() const
+			{
+				check_deref();
+				return *ptr;
+			}
+			T *operator->() const
+			{
+				check_deref();
+				return ptr;
+			}
+			T &operator[](const difference_type &n) const
+			{
+				return *(*this + n);
+			}
+
+			bool operator==(const iterator &rhs) const
+			{
+				return ptr == rhs.ptr && owner() == rhs.owner();
+			}
+			bool operator==(const const_iterator &rhs) const
+			{
+				return ptr == rhs.ptr && owner() == rhs.owner();
+			}
+			bool operator!=(const iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator!=(const const_iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const iterator &rhs) const
+			{
+				check_same(rhs.owner());
+				return ptr < rhs.ptr;
+			}
+			bool operator>(const iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		class const_iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = T;
+			using pointer = const T *;
+			using reference = const T &;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class vector;
+			friend class iterator;
+
+			const T *ptr;
+#ifdef SJTU_CHECKED_ITERATORS
+			const vector *vec;
+
+			void check_offset(difference_type n) const
+			{
+				if (vec == nullptr)
+				{
+					throw invalid_iterator();
+				}
+				difference_type pos = ptr - vec->data + n;
+				if (pos < 0 || pos > static_cast<difference_type>(vec->size_))
 				{
 					throw index_out_of_bound();
 				}
-				return iterator(pos - 1, vec);
 			}
-
-			iterator &operator--()
+			void check_deref() const
 			{
-				if (pos < 1)
+				check_offset(0);
+				if (ptr == vec->data + vec->size_)
 				{
 					throw index_out_of_bound();
 				}
-				--pos;
+			}
+			void check_same(const vector *other) const
+			{
+				if (vec != other)
+				{
+					throw invalid_iterator();
+				}
+			}
+#else
+			void check_offset(difference_type) const {}
+			void check_deref() const {}
+			void check_same(const vector *) const {}
+#endif
+
+		public:
+#ifdef SJTU_CHECKED_ITERATORS
+			const_iterator() : ptr(nullptr), vec(nullptr) {}
+			const_iterator(const T *p, const vector *v) : ptr(p), vec(v) {}
+			const_iterator(const iterator &other) : ptr(other.ptr), vec(other.vec) {}
+			const vector *owner() const { return vec; }
+#else
+			const_iterator() : ptr(nullptr) {}
+			const_iterator(const T *p, const vector *) : ptr(p) {}
+			const_iterator(const iterator &other) : ptr(other.ptr) {}
+			const vector *owner() const { return nullptr; }
+#endif
+
+			const_iterator operator+(const difference_type &n) const
+			{
+				const_iterator tmp(*this);
+				return tmp += n;
+			}
+			const_iterator operator-(const difference_type &n) const
+			{
+				const_iterator tmp(*this);
+				return tmp -= n;
+			}
+			friend const_iterator operator+(const difference_type &n, const const_iterator &it)
+			{
+				return it + n;
+			}
+
+			difference_type operator-(const const_iterator &rhs) const
+			{
+				check_same(rhs.owner());
+				return ptr - rhs.ptr;
+			}
+			const_iterator &operator+=(const difference_type &n)
+			{
+				check_offset(n);
+				ptr += n;
+				return *this;
+			}
+			const_iterator &operator-=(const difference_type &n)
+			{
+				check_offset(-n);
+				ptr -= n;
 				return *this;
 			}
 
-			T &operator*() const
+			const_iterator operator++(int)
+			{
+				const_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+			const_iterator &operator++()
+			{
+				check_offset(1);
+				++ptr;
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+			const_iterator &operator--()
+			{
+				check_offset(-1);
+				--ptr;
+				return *this;
+			}
+
+			const T &operator*() const
+			{
+				check_deref();
+				return *ptr;
+			}
+			const T *operator->() const
+			{
+				check_deref();
+				return ptr;
+			}
+			const T &operator[](const difference_type &n) const
+			{
+				return *(*this + n);
+			}
+
+			bool operator==(const iterator &rhs) const
+			{
+				return ptr == rhs.ptr && owner() == rhs.owner();
+			}
+			bool operator==(const const_iterator &rhs) const
+			{
+				return ptr == rhs.ptr && owner() == rhs.owner();
+			}
+			bool operator!=(const iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator!=(const const_iterator &rhs) const
+			{
+				return !(*this == rhs);
+			}
+			bool operator<(const const_iterator &rhs) const
+			{
+				check_same(rhs.owner());
+				return ptr < rhs.ptr;
+			}
+			bool operator>(const const_iterator &rhs) const
+			{
+				return rhs < *this;
+			}
+			bool operator<=(const const_iterator &rhs) const
+			{
+				return !(rhs < *this);
+			}
+			bool operator>=(const const_iterator &rhs) const
+			{
+				return !(*this < rhs);
+			}
+		};
+
+		vector() : data(this->inline_data()), size_(0), capacity_(N), alloc() {}
+		explicit vector(const Alloc &a) : data(this->inline_data()), size_(0), capacity_(N), alloc(a) {}
+		vector(const vector &other)
+			: inline_storage<T, N>(), stats::vector_probe(), data(this->inline_data()), size_(0), capacity_(N),
+			  alloc(alloc_traits::select_on_container_copy_construction(other.alloc))
+		{
+			try
+			{
+				reserve(other.size_);
+				copy_from(other);
+			}
+			catch (...)
+			{
+				destroy_all();
+				release(data, capacity_);
+				throw;
+			}
+		}
+		vector(vector &&other) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value)
+			: data(this->inline_data()), size_(0), capacity_(N), alloc(std::move(other.alloc))
+		{
+			steal_from(other);
+		}
+
+		~vector()
+		{
+			destroy_all();
+			release(data, capacity_); // 释放
+			capacity_ = 0;
+			data = nullptr;
+		}
+
+		vector &operator=(const vector &other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy_all();
+			if (alloc_traits::propagate_on_container_copy_assignment::value && alloc != other.alloc)
+			{
+				release(data, capacity_); // 旧内存须由旧配置器释放
+				data = this->inline_data();
+				capacity_ = N;
+			}
+			if (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				alloc = other.alloc;
+			}
+			if (capacity_ < other.size_)
+			{
+				release(data, capacity_); // 释放
+				data = this->inline_data();
+				capacity_ = N;
+				reserve(other.size_); // 分配
+			}
+			copy_from(other);
+			return *this;
+		}
+		vector &operator=(vector &&other) noexcept(
+			(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) &&
+			(N == 0 || std::is_nothrow_move_constructible<T>::value))
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy_all();
+			if (!alloc_traits::propagate_on_container_move_assignment::value && alloc != other.alloc)
+			{
+				move_from(other); // 配置器不同且不传播，不能接管对方内存
+				return *this;
+			}
+			release(data, capacity_);
+			data = this->inline_data();
+			capacity_ = N;
+			if (alloc_traits::propagate_on_container_move_assignment::value)
+			{
+				alloc = std::move(other.alloc);
+			}
+			steal_from(other);
+			return *this;
+		}
+
+		Alloc get_allocator() const
+		{
+			return alloc;
+		}
+
+		void Double()
+		{
+			reallocate(Policy::grow(capacity_));
+		}
+
+		void halve()
+		{
+			reallocate(capacity_ / 2);
+		}
+
+		T &at(const size_t &pos)
+		{
+			if (pos >= size_ || pos < 0)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+		const T &at(const size_t &pos) const
+		{
+			// return const_cast<vector<T>*>(this)->at(pos); //不确定风险
+			if (pos >= size_ || pos < 0)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+
+		T &operator[](const size_t &pos)
+		{
+			if (pos >= size_ || pos < 0)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+		const T &operator[](const size_t &pos) const
+		{
+			if (pos >= size_ || pos < 0)
+			{
+				throw index_out_of_bound();
+			}
+			return data[pos];
+		}
+
+		const T &front() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return data[0];
+		}
+		const T &back() const
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			return data[size_ - 1];
+		}
+
+		iterator begin()
+		{
+			return iterator(data, this);
+		}
+		const_iterator begin() const
+		{
+			return cbegin();
+		}
+		const_iterator cbegin() const
+		{
+			return const_iterator(data, this);
+		}
+
+		iterator end()
+		{
+			return iterator(data + size_, this);
+		}
+		const_iterator end() const
+		{
+			return cend();
+		}
+		const_iterator cend() const
+		{
+			return const_iterator(data + size_, this);
+		}
+
+		bool empty() const
+		{
+			return (size_ == 0);
+		}
+
+		size_t size() const
+		{
+			return size_;
+		}
+
+		size_t capacity() const
+		{
+			return capacity_;
+		}
+
+		// 本对象的分配与搬移计数，未定义 SJTU_VECTOR_STATS 时恒为 0
+		stats::vector_counters stats() const
+		{
+			return this->counters();
+		}
+
+		// 预留至少 n 个元素的空间，不改变 size
+		void reserve(size_t n)
+		{
+			if (n > capacity_)
+			{
+				reallocate(n);
+			}
+		}
+
+		// 释放多余容量
+		void shrink_to_fit()
+		{
+			if (capacity_ == size_)
+			{
+				return;
+			}
+			reallocate(size_);
+		}
+
+		void clear()
+		{
+			destroy_all();
+			release(data, capacity_);
+			data = this->inline_data();
+			capacity_ = N;
+		}
+
+		// 写入二进制存档（格式见 serialize.hpp）；可平凡拷贝的元素整块写出
+		template <class Serializer = serializer<T>>
+		void save(std::ostream &os) const
+		{
+			write_archive_header(os, 'V', Serializer::bitwise, sizeof(T), size_);
+			if (Serializer::bitwise)
+			{
+				write_block(os, data, size_);
+			}
+			else
+			{
+				for (size_t i = 0; i < size_; ++i)
+				{
+					Serializer::write(os, data[i]);
+				}
+			}
+			if (!os)
+			{
+				throw runtime_error();
+			}
+		}
+		// 从存档读回；流可定位时先核对剩余字节再一次分配到位，否则边读边按倍增扩容。
+		// 读取失败或数据不足时抛出 runtime_error，原内容不变
+		template <class Serializer = serializer<T>>
+		void load(std::istream &is)
+		{
+			size_t n = read_archive_header(is, 'V', Serializer::bitwise, sizeof(T));
+			vector tmp(alloc);
+			tmp.reserve(archive_reserve(is, n, Serializer::bitwise ? sizeof(T) : 1));
+			if (Serializer::bitwise)
+			{
+				while (tmp.size_ < n)
+				{
+					if (tmp.size_ == tmp.capacity_)
+					{
+						tmp.reserve(n - tmp.size_ < tmp.capacity_ ? n : tmp.capacity_ * 2);
+					}
+					size_t k = (n < tmp.capacity_ ? n : tmp.capacity_) - tmp.size_;
+					read_block(is, tmp.data + tmp.size_, k);
+					tmp.size_ += k;
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					tmp.push_back(Serializer::read(is));
+				}
+			}
+			*this = std::move(tmp);
+		}
+
+		iterator insert(iterator pos, const T &value)
+		{
+			size_t ind = pos - begin();
+			return insert(ind, value);
+		}
+		iterator insert(iterator pos, T &&value)
+		{
+			size_t ind = pos - begin();
+			return insert(ind, std::move(value));
+		}
+
+		iterator insert(const size_t &ind, const T &value)
+		{
+			if (ind < 0 || ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			return insert(ind, T(value)); // 先拷贝，value 可能引用自身元素
+		}
+
+		iterator insert(const size_t &ind, T &&value)
+		{
+			if (ind < 0 || ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			make_gap(ind, 1);
+			try
+			{
+				new (data + ind) T(std::move(value));
+			}
+			catch (...)
+			{
+				close_gap(ind);
+				throw;
+			}
+			++size_;
+			return begin() + ind;
+		}
+
+		// 区间插入：先算出最终大小，最多重新分配一次，尾部只搬移一次
+		iterator insert(iterator pos, size_t n, const T &value)
+		{
+			size_t ind = pos - begin();
+			return insert(ind, n, value);
+		}
+		iterator insert(const size_t &ind, size_t n, const T &value)
+		{
+			if (ind < 0 || ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			T tmp(value); // value 可能引用自身元素
+			make_gap(ind, n);
+			size_t i = 0;
+			try
+			{
+				for (; i < n; ++i)
+				{
+					new (data + ind + i) T(tmp);
+				}
+			}
+			catch (...)
+			{
+				for (size_t j = 0; j < i; ++j)
+				{
+					(data + ind + j)->~T();
+				}
+				close_gap(ind, n);
+				throw;
+			}
+			size_ += n;
+			return begin() + ind;
+		}
+
+		template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+		iterator insert(iterator pos, InputIt first, InputIt last)
+		{
+			size_t ind = pos - begin();
+			return insert(ind, first, last);
+		}
+		template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+		iterator insert(const size_t &ind, InputIt first, InputIt last)
+		{
+			if (ind < 0 || ind > size_)
+			{
+				throw index_out_of_bound();
+			}
+			insert_range(ind, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+			return begin() + ind;
+		}
+
+		template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+		void append(InputIt first, InputIt last)
+		{
+			insert_range(size_, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+		}
+
+		template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+		void assign(InputIt first, InputIt last)
+		{
+			destroy_all();
+			insert_range(0, first, last, typename std::iterator_traits<InputIt>::iterator_category());
+		}
+
+		iterator erase(iterator pos)
+		{
+			size_t ind = pos - begin();
+			return erase(ind);
+		}
+
+		iterator erase(const size_t &ind)
+		{
+			if (ind < 0 || ind >= size_)
+			{
+				throw index_out_of_bound();
+			}
+			remove_at(ind);
+			if (Policy::should_shrink(size_, capacity_))
+			{
+				halve();
+			}
+			return begin() + ind;
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		template <class... Args>
+		T &emplace_back(Args &&...args)
+		{
+			if (size_ >= capacity_)
+			{
+				T tmp(std::forward<Args>(args)...); // 参数可能引用自身元素，先构造再扩容
+				Double();
+				new (data + size_) T(std::move(tmp));
+			}
+			else
+			{
+				new (data + size_) T(std::forward<Args>(args)...);
+			}
+			return data[size_++];
+		}
+
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			(data + size_ - 1)->~T();
+			--size_;
+			if (Policy::should_shrink(size_, capacity_))
+			{
+				halve();
+			}
+		}
+	};
+
+	// vector<bool> 按位压缩：每个字存 64 个标志，底层直接复用 vector<unsigned long long>。
+	// 单个元素通过代理对象 reference 读写；插入删除、count、find_first/find_next
+	// 和按位运算都以整字为单位，循环足够简单，编译器可以自动向量化。
+	// 不变式：最后一个字中超出 size 的位始终为 0
+	template <class Policy, size_t N, class Alloc>
+	class vector<bool, Policy, N, Alloc>
+	{
+	public:
+		using word_type = unsigned long long;
+		static const size_t word_bits = sizeof(word_type) * CHAR_BIT;
+		static const size_t npos = static_cast<size_t>(-1);
+
+	private:
+		using word_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<word_type>;
+
+		vector<word_type, Policy, (N + word_bits - 1) / word_bits, word_alloc> words; // 按位存储
+		size_t size_;																	// 标志个数
+
+		static size_t words_for(size_t n)
+		{
+			return (n + word_bits - 1) / word_bits;
+		}
+		static word_type low_mask(size_t off) // 低 off 位为 1
+		{
+			return off == 0 ? 0 : (~word_type(0) >> (word_bits - off));
+		}
+		static size_t popcount(word_type w)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(w);
+#else
+			w = w - ((w >> 1) & 0x5555555555555555ULL);
+			w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+			w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+			return (w * 0x0101010101010101ULL) >> 56;
+#endif
+		}
+		static size_t lowest_bit(word_type w) // 要求 w != 0
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(w);
+#else
+			return popcount((w & (~w + 1)) - 1);
+#endif
+		}
+
+		word_type *wdata()
+		{
+			return words.size() == 0 ? nullptr : &words[0];
+		}
+		const word_type *wdata() const
+		{
+			return words.size() == 0 ? nullptr : &words[0];
+		}
+		void clear_tail()
+		{
+			if (size_ % word_bits != 0)
+			{
+				words[words.size() - 1] &= low_mask(size_ % word_bits);
+			}
+		}
+		void check_same_size(const vector &other) const
+		{
+			if (size_ != other.size_)
+			{
+				throw runtime_error();
+			}
+		}
+
+	public:
+		class reference
+		{
+		private:
+			friend class vector;
+			word_type *w;
+			word_type mask;
+
+			reference(word_type *w_, word_type mask_) : w(w_), mask(mask_) {}
+
+		public:
+			operator bool() const
+			{
+				return (*w & mask) != 0;
+			}
+			reference &operator=(bool x)
+			{
+				if (x)
+				{
+					*w |= mask;
+				}
+				else
+				{
+					*w &= ~mask;
+				}
+				return *this;
+			}
+			reference &operator=(const reference &x)
+			{
+				return *this = static_cast<bool>(x);
+			}
+			void flip()
+			{
+				*w ^= mask;
+			}
+		};
+		using const_reference = bool;
+
+		class const_iterator;
+		class iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = bool;
+			using pointer = void;
+			using reference = typename vector::reference;
+			using iterator_category = std::random_access_iterator_tag;
+
+		private:
+			friend class vector;
+			friend class const_iterator;
+
+			word_type *p; // 所在字
+			size_t off;	  // 字内位号，始终小于 word_bits
+
+		public:
+			iterator() : p(nullptr), off(0) {}
+			iterator(word_type *p_, size_t off_) : p(p_), off(off_) {}
+
+			iterator &operator+=(const difference_type &n)
+			{
+				difference_type pos = static_cast<difference_type>(off) + n;
+				difference_type wb = static_cast<difference_type>(word_bits);
+				difference_type step = pos >= 0 ? pos / wb : -((-pos - 1) / wb) - 1;
+				p += step;
+				off = static_cast<size_t>(pos - step * wb);
+				return *this;
+			}
+			iterator &operator-=(const difference_type &n)
+			{
+				return *this += -n;
+			}
+			iterator operator+(const difference_type &n) const
+			{
+				iterator tmp(*this);
+				return tmp += n;
+			}
+			iterator operator-(const difference_type &n) const
+			{
+				iterator tmp(*this);
+				return tmp -= n;
+			}
+			friend iterator operator+(const difference_type &n, const iterator &it)
+			{
+				return it + n;
+			}
+			difference_type operator-(const iterator &rhs) const
+			{
+				return (p - rhs.p) * static_cast<difference_type>(word_bits) + static_cast<difference_type>(off) - static_cast<difference_type>(rhs.off);
+			}
+
+			iterator &operator++()
+			{
+				if (++off == word_bits)
+				{
+					++p;
+					off = 0;
+				}
+				return *this;
+			}
+			iterator operator++(int)
+			{
+				iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+			iterator &operator--()
+			{
+				if (off == 0)
+				{
+					--p;
+					off = word_bits;
+				}
+				--off;
+				return *this;
+			}
+			iterator operator--(int)
+			{
+				iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			reference operator*() const
+			{
+				return reference(p, word_type(1) << off);
+			}
+			reference operator[](const difference_type &n) const
+			{
+				return *(*this + n);
+			}
+
+			bool operator==(const iterator &rhs) const
+			{
+				return p == rhs.p && off == rhs.off;
+			}
+			bool operator!=(const iterator &rhs) const
 			{
-				return vec->data[pos];
+				return !(*this == rhs);
 			}
-
-			bool operator==(const iterator &rhs) const
+			bool operator<(const iterator &rhs) const
 			{
-				return (pos == rhs.pos) && (vec == rhs.vec);
+				return p < rhs.p || (p == rhs.p && off < rhs.off);
 			}
-			bool operator==(const const_iterator &rhs) const
+			bool operator>(const iterator &rhs) const
 			{
-				return (pos == rhs.pos) && (vec == rhs.vec);
+				return rhs < *this;
 			}
-
-			bool operator!=(const iterator &rhs) const
+			bool operator<=(const iterator &rhs) const
 			{
-				return !(*this == rhs);
+				return !(rhs < *this);
 			}
-			bool operator!=(const const_iterator &rhs) const
+			bool operator>=(const iterator &rhs) const
 			{
-				return !(*this == rhs);
+				return !(*this < rhs);
 			}
 		};
 
@@ -164,327 +1364,348 @@ namespace sjtu
 		{
 		public:
 			using difference_type = std::ptrdiff_t;
-			using value_type = T;
-			using pointer = T *;
-			using reference = T &;
-			using iterator_category = std::output_iterator_tag;
+			using value_type = bool;
+			using pointer = void;
+			using reference = bool;
+			using iterator_category = std::random_access_iterator_tag;
 
 		private:
-			size_t pos;
-			const vector *vec;
+			friend class vector;
+
+			const word_type *p;
+			size_t off;
 
 		public:
-			const_iterator() : pos(0), vec(nullptr) {}
-			const_iterator(size_t position, vector *v) : pos(position), vec(v) {}
-			const_iterator(const const_iterator &other) : pos(other.pos), vec(other.vec) {}
+			const_iterator() : p(nullptr), off(0) {}
+			const_iterator(const word_type *p_, size_t off_) : p(p_), off(off_) {}
+			const_iterator(const iterator &other) : p(other.p), off(other.off) {}
 
-			const_iterator operator+(const int &n) const
+			const_iterator &operator+=(const difference_type &n)
 			{
-				if (pos + n >= vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				return const_iterator(pos + n, vec);
+				difference_type pos = static_cast<difference_type>(off) + n;
+				difference_type wb = static_cast<difference_type>(word_bits);
+				difference_type step = pos >= 0 ? pos / wb : -((-pos - 1) / wb) - 1;
+				p += step;
+				off = static_cast<size_t>(pos - step * wb);
+				return *this;
 			}
-			const_iterator operator-(const int &n) const
+			const_iterator &operator-=(const difference_type &n)
 			{
-				if (pos - n < 0)
-				{
-					throw index_out_of_bound();
-				}
-				return const_iterator(pos - n, vec);
+				return *this += -n;
 			}
-
-			int operator-(const const_iterator &rhs) const
+			const_iterator operator+(const difference_type &n) const
 			{
-				if (vec != rhs.vec)
-				{
-					throw invalid_iterator();
-				}
-				return pos - rhs.pos;
+				const_iterator tmp(*this);
+				return tmp += n;
 			}
-			const_iterator &operator+=(const int &n)
+			const_iterator operator-(const difference_type &n) const
 			{
-				if (pos + n >= vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				pos += n;
-				return *this;
+				const_iterator tmp(*this);
+				return tmp -= n;
 			}
-			const_iterator &operator-=(const int &n)
+			friend const_iterator operator+(const difference_type &n, const const_iterator &it)
 			{
-				if (pos - n < 0)
-				{
-					throw index_out_of_bound();
-				}
-				pos -= n;
-				return *this;
+				return it + n;
 			}
-
-			const_iterator operator++(int)
+			difference_type operator-(const const_iterator &rhs) const
 			{
-				if (pos + 1 > vec->size_)
-				{
-					throw index_out_of_bound();
-				}
-				return const_iterator(pos + 1, vec);
+				return (p - rhs.p) * static_cast<difference_type>(word_bits) + static_cast<difference_type>(off) - static_cast<difference_type>(rhs.off);
 			}
 
 			const_iterator &operator++()
 			{
-				if (pos + 1 > vec->size_)
+				if (++off == word_bits)
 				{
-					throw index_out_of_bound();
+					++p;
+					off = 0;
 				}
-				++pos;
 				return *this;
 			}
-
-			const_iterator operator--(int)
+			const_iterator operator++(int)
 			{
-				if (pos < 1)
-				{
-					throw index_out_of_bound();
-				}
-				return const_iterator(pos - 1, vec);
+				const_iterator tmp(*this);
+				++*this;
+				return tmp;
 			}
-
 			const_iterator &operator--()
 			{
-				if (pos < 1)
+				if (off == 0)
 				{
-					throw index_out_of_bound();
+					--p;
+					off = word_bits;
 				}
-				--pos;
+				--off;
 				return *this;
 			}
-
-			T &operator*() const
+			const_iterator operator--(int)
 			{
-				return vec->data[pos];
+				const_iterator tmp(*this);
+				--*this;
+				return tmp;
 			}
 
-			bool operator==(const iterator &rhs) const
+			bool operator*() const
 			{
-				return (pos == rhs.pos) && (vec == rhs.vec);
+				return (*p >> off) & 1;
 			}
-			bool operator==(const const_iterator &rhs) const
+			bool operator[](const difference_type &n) const
 			{
-				return (pos == rhs.pos) && (vec == rhs.vec);
+				return *(*this + n);
 			}
 
-			bool operator!=(const iterator &rhs) const
+			bool operator==(const const_iterator &rhs) const
 			{
-				return !(*this == rhs);
+				return p == rhs.p && off == rhs.off;
 			}
 			bool operator!=(const const_iterator &rhs) const
 			{
 				return !(*this == rhs);
 			}
-		};
-
-		vector() : data(nullptr), size_(0), capacity(0) {}
-		vector(const vector &other) : size_(other.size_), capacity(other.capacity)
-		{
-			data = alloc.allocate(capacity); // 分配
-			for (size_t i = 0; i < size_; ++i)
-			{
-				data[i] = other.data[i];
-			}
-		}
-
-		~vector()
-		{
-			for (size_t i = 0; i < size_; ++i)
+			bool operator<(const const_iterator &rhs) const
 			{
-				(data + i)->~T();
+				return p < rhs.p || (p == rhs.p && off < rhs.off);
 			}
-			alloc.deallocate(data, capacity); // 释放
-			size_ = 0;
-			capacity = 0;
-			data = nullptr;
-		}
-
-		vector &operator=(const vector &other)
-		{
-			if (this == &other)
+			bool operator>(const const_iterator &rhs) const
 			{
-				return *this;
+				return rhs < *this;
 			}
-			for (size_t i = 0; i < size_; ++i)
+			bool operator<=(const const_iterator &rhs) const
 			{
-				(data + i)->~T();
+				return !(rhs < *this);
 			}
-			alloc.deallocate(data, capacity); // 释放
-			size_ = other.size_;
-			capacity = other.capacity;
-			data = alloc.allocate(capacity); // 分配
-			for (size_t i = 0; i < size_; ++i)
+			bool operator>=(const const_iterator &rhs) const
 			{
-				data[i] = other.data[i];
+				return !(*this < rhs);
 			}
-			return *this;
-		}
+		};
 
-		void Double()
+		vector() : size_(0) {}
+		explicit vector(const Alloc &a) : words(word_alloc(a)), size_(0) {}
+		vector(const vector &other) : words(other.words), size_(other.size_) {}
+		vector(vector &&other) noexcept(std::is_nothrow_move_constructible<decltype(words)>::value)
+			: words(std::move(other.words)), size_(other.size_)
 		{
-			if (capacity == 0)
-			{
-				capacity = 1;
-			}
-			capacity *= 2;
-			T *tmp = alloc.allocate(capacity);
-			for (size_t i = 0; i < size_; ++i)
-			{
-				new (tmp + i) T(data[i]); // 直接赋值出错 可用c++20 std::construct_at(tmp + i, data[i]);
-			}
-			for (size_t i = 0; i < size_; ++i)
-			{
-				(data + i)->~T();
-			}
-			if (data != nullptr)
-			{
-				alloc.deallocate(data, capacity);
-			}
-			data = tmp;
-			tmp = nullptr;
+			other.size_ = 0;
 		}
 
-		void halve()
+		vector &operator=(const vector &other)
 		{
-			capacity /= 2;
-			T *tmp = alloc.allocate(capacity);
-			for (size_t i = 0; i < size_; ++i)
-			{
-				new (tmp + i) T(data[i]);
-			}
-			for (size_t i = 0; i < size_; ++i)
-			{
-				(data + i)->~T();
-			}
-			if (data != nullptr)
+			words = other.words;
+			size_ = other.size_;
+			return *this;
+		}
+		vector &operator=(vector &&other)
+		{
+			if (this == &other)
 			{
-				alloc.deallocate(data, capacity);
+				return *this;
 			}
-			data = tmp;
-			tmp = nullptr;
+			words = std::move(other.words);
+			size_ = other.size_;
+			other.size_ = 0;
+			return *this;
 		}
 
-		T &at(const size_t &pos)
+		reference at(const size_t &pos)
 		{
-			if (pos >= size_ || pos < 0)
+			if (pos >= size_)
 			{
 				throw index_out_of_bound();
 			}
-			return data[pos];
+			return reference(wdata() + pos / word_bits, word_type(1) << (pos % word_bits));
 		}
-		const T &at(const size_t &pos) const
+		bool at(const size_t &pos) const
 		{
-			// return const_cast<vector<T>*>(this)->at(pos); //不确定风险
-			if (pos >= size_ || pos < 0)
+			if (pos >= size_)
 			{
 				throw index_out_of_bound();
 			}
-			return data[pos];
+			return (wdata()[pos / word_bits] >> (pos % word_bits)) & 1;
 		}
-
-		T &operator[](const size_t &pos)
+		reference operator[](const size_t &pos)
 		{
-			if (pos >= size_ || pos < 0)
-			{
-				throw index_out_of_bound();
-			}
-			return data[pos];
+			return at(pos);
 		}
-		const T &operator[](const size_t &pos) const
+		bool operator[](const size_t &pos) const
 		{
-			if (pos >= size_ || pos < 0)
-			{
-				throw index_out_of_bound();
-			}
-			return data[pos];
+			return at(pos);
 		}
 
-		const T &front() const
+		bool front() const
 		{
 			if (size_ == 0)
 			{
 				throw container_is_empty();
 			}
-			return data[0];
+			return at(0);
 		}
-		const T &back() const
+		bool back() const
 		{
 			if (size_ == 0)
 			{
 				throw container_is_empty();
 			}
-			return data[size_ - 1];
+			return at(size_ - 1);
 		}
 
 		iterator begin()
 		{
-			return iterator(0, this);
+			return iterator(wdata(), 0);
+		}
+		const_iterator begin() const
+		{
+			return cbegin();
 		}
 		const_iterator cbegin() const
 		{
-			return const_iterator(0, const_cast<vector *>(this));
+			return const_iterator(wdata(), 0);
 		}
-
 		iterator end()
 		{
-			return iterator(size_, this);
+			return begin() + size_;
+		}
+		const_iterator end() const
+		{
+			return cend();
 		}
 		const_iterator cend() const
 		{
-			return const_iterator(size_, const_cast<vector *>(this));
+			return cbegin() + size_;
 		}
 
 		bool empty() const
 		{
-			return (size_ == 0);
+			return size_ == 0;
 		}
-
 		size_t size() const
 		{
 			return size_;
 		}
+		size_t capacity() const
+		{
+			return words.capacity() * word_bits;
+		}
 
+		// 底层按字存储的分配与搬移计数，元素个数以字计
+		stats::vector_counters stats() const
+		{
+			return words.stats();
+		}
+		void reserve(size_t n)
+		{
+			words.reserve(words_for(n));
+		}
+		void shrink_to_fit()
+		{
+			words.shrink_to_fit();
+		}
 		void clear()
 		{
-			for (size_t i = 0; i < size_; ++i)
+			words.clear();
+			size_ = 0;
+		}
+
+		// 存档：文件头记录标志个数，之后是按字存储的 vector 存档
+		void save(std::ostream &os) const
+		{
+			write_archive_header(os, 'B', true, sizeof(word_type), size_);
+			words.save(os);
+		}
+		void load(std::istream &is)
+		{
+			size_t n = read_archive_header(is, 'B', true, sizeof(word_type));
+			vector<word_type, Policy, (N + word_bits - 1) / word_bits, word_alloc> tmp(words.get_allocator());
+			tmp.load(is);
+			if (tmp.size() != words_for(n) || (n % word_bits != 0 && (tmp[tmp.size() - 1] & ~low_mask(n % word_bits)) != 0))
 			{
-				(data + i)->~T();
+				throw runtime_error();
 			}
-			alloc.deallocate(data, capacity);
-			size_ = 0;
-			capacity = 0;
-			data = nullptr;
+			words = std::move(tmp);
+			size_ = n;
 		}
 
-		iterator insert(iterator pos, const T &value)
+		// 调整为 n 个标志，新增部分取 value
+		void resize(size_t n, bool value = false)
+		{
+			if (n < size_)
+			{
+				while (words.size() > words_for(n))
+				{
+					words.pop_back();
+				}
+				size_ = n;
+				clear_tail();
+				return;
+			}
+			size_t old = size_;
+			words.reserve(words_for(n));
+			if (value && old % word_bits != 0)
+			{
+				words[words.size() - 1] |= ~low_mask(old % word_bits);
+			}
+			while (words.size() < words_for(n))
+			{
+				words.push_back(value ? ~word_type(0) : word_type(0));
+			}
+			size_ = n;
+			clear_tail();
+		}
+
+		void push_back(bool value)
+		{
+			if (size_ % word_bits == 0)
+			{
+				words.push_back(0);
+			}
+			if (value)
+			{
+				words[size_ / word_bits] |= word_type(1) << (size_ % word_bits);
+			}
+			++size_;
+		}
+		void pop_back()
+		{
+			if (size_ == 0)
+			{
+				throw container_is_empty();
+			}
+			--size_;
+			words[size_ / word_bits] &= ~(word_type(1) << (size_ % word_bits));
+			if (size_ % word_bits == 0)
+			{
+				words.pop_back();
+			}
+		}
+
+		iterator insert(iterator pos, bool value)
 		{
 			size_t ind = pos - begin();
 			return insert(ind, value);
 		}
-
-		iterator insert(const size_t &ind, const T &value)
+		// 插入位之后的所有位整字左移一位
+		iterator insert(const size_t &ind, bool value)
 		{
-			if (ind < 0 || ind > size_)
+			if (ind > size_)
 			{
 				throw index_out_of_bound();
 			}
-			if (size_ >= capacity)
+			if (size_ % word_bits == 0)
 			{
-				Double();
+				words.push_back(0);
 			}
-			++size_;
-			for (size_t i = size_; i - ind > 0; --i)
+			word_type *w = wdata();
+			size_t wi = ind / word_bits, off = ind % word_bits;
+			for (size_t i = words.size() - 1; i > wi; --i)
+			{
+				w[i] = (w[i] << 1) | (w[i - 1] >> (word_bits - 1));
+			}
+			word_type low = w[wi] & low_mask(off);
+			w[wi] = low | ((w[wi] & ~low_mask(off)) << 1);
+			if (value)
 			{
-				data[i] = data[i - 1];
+				w[wi] |= word_type(1) << off;
 			}
-			data[ind] = value;
+			++size_;
 			return begin() + ind;
 		}
 
@@ -493,51 +1714,158 @@ namespace sjtu
 			size_t ind = pos - begin();
 			return erase(ind);
 		}
-
+		// 删除位之后的所有位整字右移一位
 		iterator erase(const size_t &ind)
 		{
-			if (ind < 0 || ind >= size_)
+			if (ind >= size_)
 			{
 				throw index_out_of_bound();
 			}
-			if (size_ <= capacity / 3)
+			word_type *w = wdata();
+			size_t n = words.size();
+			size_t wi = ind / word_bits, off = ind % word_bits;
+			word_type low = w[wi] & low_mask(off);
+			w[wi] = low | ((w[wi] >> 1) & ~low_mask(off));
+			if (wi + 1 < n)
 			{
-				halve();
+				w[wi] |= w[wi + 1] << (word_bits - 1);
+			}
+			for (size_t i = wi + 1; i < n; ++i)
+			{
+				w[i] = (w[i] >> 1) | (i + 1 < n ? w[i + 1] << (word_bits - 1) : 0);
 			}
 			--size_;
-			for (size_t i = ind; i < size_; ++i)
+			if (size_ % word_bits == 0)
 			{
-				data[i] = data[i + 1];
+				words.pop_back();
 			}
-			(data + ind)->~T();
 			return begin() + ind;
 		}
 
-		void push_back(const T &value)
+		// 置位个数
+		size_t count() const
 		{
-			if (size_ >= capacity)
+			const word_type *w = wdata();
+			size_t n = words.size(), res = 0;
+			for (size_t i = 0; i < n; ++i)
 			{
-				Double();
+				res += popcount(w[i]);
 			}
-			new (data + size_) T(value);
-			++size_;
+			return res;
+		}
+		// 第一个置位的下标，没有则返回 npos
+		size_t find_first() const
+		{
+			const word_type *w = wdata();
+			size_t n = words.size();
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (w[i] != 0)
+				{
+					return i * word_bits + lowest_bit(w[i]);
+				}
+			}
+			return npos;
+		}
+		// pos 之后第一个置位的下标，没有则返回 npos
+		size_t find_next(size_t pos) const
+		{
+			if (pos == npos || pos + 1 >= size_)
+			{
+				return npos;
+			}
+			++pos;
+			const word_type *w = wdata();
+			size_t n = words.size(), wi = pos / word_bits;
+			word_type cur = w[wi] & ~low_mask(pos % word_bits);
+			while (cur == 0)
+			{
+				if (++wi == n)
+				{
+					return npos;
+				}
+				cur = w[wi];
+			}
+			return wi * word_bits + lowest_bit(cur);
 		}
 
-		void pop_back()
+		vector &operator&=(const vector &rhs)
 		{
-			if (size_ == 0)
+			check_same_size(rhs);
+			word_type *w = wdata();
+			const word_type *r = rhs.wdata();
+			size_t n = words.size();
+			for (size_t i = 0; i < n; ++i)
 			{
-				throw container_is_empty();
+				w[i] &= r[i];
+			}
+			return *this;
+		}
+		vector &operator|=(const vector &rhs)
+		{
+			check_same_size(rhs);
+			word_type *w = wdata();
+			const word_type *r = rhs.wdata();
+			size_t n = words.size();
+			for (size_t i = 0; i < n; ++i)
+			{
+				w[i] |= r[i];
 			}
-			if (size_ <= capacity / 3)
+			return *this;
+		}
+		vector &operator^=(const vector &rhs)
+		{
+			check_same_size(rhs);
+			word_type *w = wdata();
+			const word_type *r = rhs.wdata();
+			size_t n = words.size();
+			for (size_t i = 0; i < n; ++i)
 			{
-				halve();
+				w[i] ^= r[i];
 			}
-			(data + size_ - 1)->~T();
-			--size_;
+			return *this;
+		}
+		// 全部取反
+		vector &flip()
+		{
+			word_type *w = wdata();
+			size_t n = words.size();
+			for (size_t i = 0; i < n; ++i)
+			{
+				w[i] = ~w[i];
+			}
+			clear_tail();
+			return *this;
+		}
+
+		vector operator~() const
+		{
+			vector res(*this);
+			res.flip();
+			return res;
+		}
+		friend vector operator&(vector lhs, const vector &rhs)
+		{
+			lhs &= rhs;
+			return lhs;
+		}
+		friend vector operator|(vector lhs, const vector &rhs)
+		{
+			lhs |= rhs;
+			return lhs;
+		}
+		friend vector operator^(vector lhs, const vector &rhs)
+		{
+			lhs ^= rhs;
+			return lhs;
 		}
 	};
 
+	// 小容量向量：前 N 个元素放在对象内部，超过 N 才转到堆上；
+	// 与 vector 共用同一份实现，溢出后的行为与普通 vector 完全相同
+	template <typename T, size_t N, class Policy = default_growth_policy, class Alloc = std::allocator<T>>
+	using small_vector = vector<T, Policy, N, Alloc>;
+
 }
 
 #endif